@@ -0,0 +1,443 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "fraction_octree.hpp"
+#include "fraction_shard.hpp"
+#include "fraction_simd.hpp"
+#include "fraction_sparse.hpp"
+#include "fraction_stream.hpp"
+
+//benchmark suite: ns/cell of get_mc_vol, get_mc_area, get_ms_area, and get_ms_len per table index
+//and on synthetic grids, written as JSON and compared against a stored baseline.
+//usage: bench [--n 128] [--runs 5] [--filter str] [--json out.json] [--baseline base.json] [--tolerance 0.15]
+
+using namespace Fraction;
+
+struct BenchResult
+{
+	std::string name;
+	double ns_per_cell;
+	double checksum;
+};
+
+struct BenchOptions
+{
+	iType n = 128;
+	int runs = 5;
+	std::string filter, json, baseline;
+	double tolerance = 0.15;
+};
+
+//best of opt.runs in ns per cell; f returns a checksum so that the work is not optimized away
+void run_bench(const BenchOptions& opt, std::vector<BenchResult>& results, const std::string& name, const double cells, const std::function<double()>& f)
+{
+	if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+	double best = 1e300, checksum = 0.0;
+	for (int r = 0; r < opt.runs; ++r) {
+		const auto t0 = std::chrono::steady_clock::now();
+		checksum = f();
+		const auto t1 = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+	}
+	results.push_back({ name, best / cells, checksum });
+	std::printf("%-36s %9.2f ns/cell  %.10g\n", name.c_str(), best / cells, checksum);
+}
+
+//=================================================================================================
+//		per table index
+//=================================================================================================
+
+//random cells whose corners have the signs given by the table index
+template<std::size_t C>
+std::vector<std::array<fType, C>> make_index_cells(const iType table_index, const std::size_t n, std::mt19937& rng)
+{
+	std::uniform_real_distribution<fType> u(0.01, 1.0);
+	std::vector<std::array<fType, C>> cells(n);
+	for (std::array<fType, C>& v : cells)
+		for (std::size_t c = 0; c < C; ++c) v[c] = (table_index >> c) & 1 ? -u(rng) : u(rng);
+	return cells;
+}
+
+template<typename V, typename F>
+double sum_cells(const std::vector<V>& cells, F&& f)
+{
+	double sum = 0.0;
+	for (const V& v : cells) sum += f(v);
+	return sum;
+}
+
+void bench_indices(const BenchOptions& opt, std::vector<BenchResult>& results)
+{
+	constexpr std::size_t num_cells = 4096;
+	std::mt19937 rng(1);
+	for (iType t = 0; t < 256; ++t) {
+		const std::vector<S8> cells = make_index_cells<8>(t, num_cells, rng);
+		const std::string index = "/index/" + std::to_string(t);
+		run_bench(opt, results, "mc_vol" + index, num_cells, [&]() { return sum_cells(cells, [](const S8& v) { return get_mc_vol(v); }); });
+		run_bench(opt, results, "mc_area" + index, num_cells, [&]() { return sum_cells(cells, [](const S8& v) { return get_mc_area(v); }); });
+		if (mc_vol_fits[mc_case_table[t].C].num > 0)
+			run_bench(opt, results, "mc_vol_approx" + index, num_cells, [&]() { return sum_cells(cells, [](const S8& v) { return get_mc_vol_approx(v); }); });
+	}
+	for (iType t = 0; t < 16; ++t) {
+		const std::vector<S4> cells = make_index_cells<4>(t, num_cells, rng);
+		const std::string index = "/index/" + std::to_string(t);
+		run_bench(opt, results, "ms_area" + index, num_cells, [&]() { return sum_cells(cells, [](const S4& v) { return get_ms_area(v); }); });
+		run_bench(opt, results, "ms_len" + index, num_cells, [&]() { return sum_cells(cells, [](const S4& v) { return get_ms_len(v); }); });
+	}
+}
+
+//largest |get_mc_vol_approx - get_mc_vol| over random cells of every fitted table index;
+//returns false if it exceeds the documented mc_vol_approx_error
+bool check_approx_error()
+{
+	constexpr std::size_t num_cells = 4096;
+	std::mt19937 rng(2);
+	fType error = 0.0;
+	for (iType t = 0; t < 256; ++t) {
+		if (mc_vol_fits[mc_case_table[t].C].num == 0) continue;
+		for (const S8& v : make_index_cells<8>(t, num_cells, rng)) error = std::max(error, std::abs(get_mc_vol_approx(v) - get_mc_vol(v)));
+	}
+	std::printf("mc_vol_approx max error %.4f (bound %.4f)\n", error, mc_vol_approx_error);
+	return error <= mc_vol_approx_error;
+}
+
+//=================================================================================================
+//		synthetic grids
+//=================================================================================================
+
+//level set sampled at the nodes of an n^3 grid on [0, 1]^3 (and its y = 0.6 slice at 8n x 8n for the ms-style functions)
+struct BenchGrid
+{
+	std::string name;
+	std::function<fType(fType, fType, fType)> f;
+};
+
+std::vector<BenchGrid> make_bench_grids(const iType n)
+{
+	const auto length = [](fType x, fType y, fType z) { return std::sqrt(x * x + y * y + z * z); };
+	return {
+		//a smooth surface: few cells cross it
+		{ "sphere", [=](fType x, fType y, fType z) { return length(x - 0.5, y - 0.5, z - 0.5) - 0.3; } },
+		{ "torus", [=](fType x, fType y, fType z) {
+			const fType q = std::sqrt((x - 0.5) * (x - 0.5) + (y - 0.5) * (y - 0.5)) - 0.3;
+			return length(q, z - 0.5, 0.0) - 0.1;
+		} },
+		//many thin parallel sheets: a few cases dominate
+		{ "thin-sheet", [n](fType x, fType y, fType z) { return std::abs(std::sin(0.25 * n * (z + 0.05 * x + 0.03 * y))) - 0.2; } },
+		//high-frequency noise: most cells are mixed and the case distribution is close to uniform
+		{ "noise", [](fType x, fType y, fType z) {
+			return std::sin(97.0 * x + 13.0 * y) * std::cos(89.0 * z + 7.0 * x) + 0.5 * std::sin(71.0 * y - 53.0 * z);
+		} },
+		//mostly uniform: a small sphere, so that only a narrow band of cells crosses the surface
+		{ "narrow-band", [=](fType x, fType y, fType z) { return length(x - 0.3, y - 0.6, z - 0.4) - 0.05; } },
+		//droplets of radius 1.2 nodes on a lattice 4 nodes apart: (n / 4)^3 connected regions, 10^5 at n = 188
+		{ "droplets", [=](fType x, fType y, fType z) {
+			const auto d = [n](fType x) { return 0.25 * n * x - std::floor(0.25 * n * x) - 0.5; };
+			return length(d(x), d(y), d(z)) - 0.3;
+		} },
+	};
+}
+
+//sparse copy of phi: the bricks whose nodes or neighbor nodes have both signs are allocated,
+//so that every cell crossing the surface is evaluated from the same values as in phi
+MCSparseGrid<fType> make_bench_sparse_grid(const fType* phi, const iType n)
+{
+	MCSparseGrid<fType> grid(n, n, n, 1.0);
+	const iType s = mc_sparse_brick;
+	for (iType bk = 0; bk < grid.bz; ++bk) {
+		for (iType bj = 0; bj < grid.by; ++bj) {
+			for (iType bi = 0; bi < grid.bx; ++bi) {
+				bool inside = false, outside = false;
+				for (iType k = std::max(bk * s - 1, 0); k < std::min(bk * s + s + 1, n); ++k)
+					for (iType j = std::max(bj * s - 1, 0); j < std::min(bj * s + s + 1, n); ++j)
+						for (iType i = std::max(bi * s - 1, 0); i < std::min(bi * s + s + 1, n); ++i)
+							(phi[i + std::size_t(n) * (j + std::size_t(n) * k)] < iso_value ? inside : outside) = true;
+				if (!(inside && outside)) {
+					grid.set_tile(bi, bj, bk, inside ? -1.0 : 1.0);
+					continue;
+				}
+				for (iType k = bk * s; k < std::min(bk * s + s, n); ++k)
+					for (iType j = bj * s; j < std::min(bj * s + s, n); ++j)
+						for (iType i = bi * s; i < std::min(bi * s + s, n); ++i) grid.set(i, j, k, phi[i + std::size_t(n) * (j + std::size_t(n) * k)]);
+			}
+		}
+	}
+	return grid;
+}
+
+void bench_grids(const BenchOptions& opt, std::vector<BenchResult>& results)
+{
+	const iType n = opt.n;
+	const double cells = double(n - 1) * (n - 1) * (n - 1);
+	for (const BenchGrid& g : make_bench_grids(n)) {
+		std::vector<fType> phi(std::size_t(n) * n * n);
+		for (iType k = 0; k < n; ++k)
+			for (iType j = 0; j < n; ++j)
+				for (iType i = 0; i < n; ++i) phi[i + std::size_t(n) * (j + std::size_t(n) * k)] = g.f(fType(i) / n, fType(j) / n, fType(k) / n);
+		const fType* p = phi.data();
+		const MCPyramid pyramid(p, n, n, n);
+		const auto at = [p, n](iType i, iType j, iType k) { return p[i + std::size_t(n) * (j + std::size_t(n) * k)]; };
+		const auto per_cell = [&](auto&& f) {
+			double sum = 0.0;
+			for (iType k = 0; k + 1 < n; ++k)
+				for (iType j = 0; j + 1 < n; ++j)
+					for (iType i = 0; i + 1 < n; ++i)
+						sum += f(S8{ at(i, j, k), at(i + 1, j, k), at(i + 1, j + 1, k), at(i, j + 1, k),
+							at(i, j, k + 1), at(i + 1, j, k + 1), at(i + 1, j + 1, k + 1), at(i, j + 1, k + 1) });
+			return sum;
+		};
+
+		const std::string grid = "/grid/" + g.name;
+		run_bench(opt, results, "mc_vol" + grid, cells, [&]() { return per_cell([](const S8& v) { return get_mc_vol(v); }); });
+		run_bench(opt, results, "mc_area" + grid, cells, [&]() { return per_cell([](const S8& v) { return get_mc_area(v); }); });
+		run_bench(opt, results, "mc_vol_grid" + grid, cells, [&]() { return get_mc_vol_grid(p, n, n, n); });
+		run_bench(opt, results, "mc_area_grid" + grid, cells, [&]() { return get_mc_area_grid(p, n, n, n); });
+		run_bench(opt, results, "mc_area_grid_aniso" + grid, cells, [&]() { return get_mc_area_grid(p, n, n, n, MCSpacing<fType>{ 1.0, 0.5, 2.0 }); });
+		//the cells of the 8 middle layers in structure-of-arrays form, per cell and through the batch entry points
+		//(vectorized classification and edge fractions when built with -mavx2 or -mavx512f)
+		std::array<std::vector<fType>, 8> soa;
+		for (iType k = n / 2 - 4; k < n / 2 + 4; ++k)
+			for (iType j = 0; j + 1 < n; ++j)
+				for (iType i = 0; i + 1 < n; ++i)
+					for (iType c = 0; c < 8; ++c) soa[c].push_back(at(i + mc_corners[c][0], j + mc_corners[c][1], k + mc_corners[c][2]));
+		const SoA8 soa_cells{ soa[0].data(), soa[1].data(), soa[2].data(), soa[3].data(), soa[4].data(), soa[5].data(), soa[6].data(), soa[7].data() };
+		const std::size_t num_soa = soa[0].size();
+		std::vector<fType> batch(num_soa);
+		const auto sum_batch = [&]() { return get_pairwise_sum(batch.data(), batch.size()); };
+		run_bench(opt, results, "mc_vol_soa" + grid, double(num_soa), [&]() {
+			for (std::size_t i = 0; i < num_soa; ++i) batch[i] = get_mc_vol(get_mc_batch_cell(soa_cells, i));
+			return sum_batch();
+		});
+		run_bench(opt, results, "mc_vol_batch" + grid, double(num_soa), [&]() { get_mc_vol_batch(soa_cells, num_soa, batch.data()); return sum_batch(); });
+		run_bench(opt, results, "mc_area_soa" + grid, double(num_soa), [&]() {
+			for (std::size_t i = 0; i < num_soa; ++i) batch[i] = get_mc_area(get_mc_batch_cell(soa_cells, i));
+			return sum_batch();
+		});
+		run_bench(opt, results, "mc_area_batch" + grid, double(num_soa), [&]() { get_mc_area_batch(soa_cells, num_soa, batch.data()); return sum_batch(); });
+		//volume, area, and the welded mesh into buffers sized by a first call
+		MCMesh<fType> mesh;
+		fType mesh_vol, mesh_area;
+		get_mc_vol_area_grid(p, n, n, n, mesh_vol, mesh_area, &mesh);
+		std::vector<fType> mesh_vertices(3 * mesh.num_vertices);
+		std::vector<std::uint32_t> mesh_triangles(3 * mesh.num_triangles);
+		run_bench(opt, results, "mc_vol_area_grid_mesh" + grid, cells, [&]() {
+			mesh = { mesh_vertices.data(), mesh_triangles.data(), mesh_vertices.size() / 3, mesh_triangles.size() / 3 };
+			get_mc_vol_area_grid(p, n, n, n, mesh_vol, mesh_area, &mesh);
+			return mesh_vol + mesh_area + double(mesh.num_triangles);
+		});
+		run_bench(opt, results, "mc_measures_grid" + grid, cells, [&]() {
+			const MCMeasures<fType> m = get_mc_measures_grid(p, n, n, n);
+			return m.vol + m.area + m.moment[0] + m.second_moment[0][1];
+		});
+		run_bench(opt, results, "mc_vol_grid_approx" + grid, cells, [&]() { return get_mc_vol_grid_approx(p, n, n, n); });
+		run_bench(opt, results, "mc_vol_grid_binned" + grid, cells, [&]() { return get_mc_vol_grid_binned(p, n, n, n); });
+		run_bench(opt, results, "mc_area_grid_binned" + grid, cells, [&]() { return get_mc_area_grid_binned(p, n, n, n); });
+		run_bench(opt, results, "mc_vol_grid_pyramid" + grid, cells, [&]() { return get_mc_vol_grid(pyramid, p); });
+		run_bench(opt, results, "mc_area_grid_pyramid" + grid, cells, [&]() { return get_mc_area_grid(pyramid, p); });
+		std::vector<fType> vol_fraction(std::size_t(n - 1) * (n - 1) * (n - 1)), face_fraction[3];
+		for (std::vector<fType>& f : face_fraction) f.resize(std::size_t(n) * (n - 1) * (n - 1));
+		run_bench(opt, results, "mc_fraction_fields" + grid, cells, [&]() {
+			get_mc_fraction_fields(p, n, n, n, vol_fraction.data(), face_fraction[0].data(), face_fraction[1].data(), face_fraction[2].data(), ThreadExecutor{ 1 });
+			return vol_fraction[vol_fraction.size() / 2] + face_fraction[2][face_fraction[2].size() / 2];
+		});
+		std::vector<fType> grad(phi.size());
+		run_bench(opt, results, "mc_vol_grad_grid" + grid, cells, [&]() { return get_mc_vol_grad_grid(p, n, n, n, grad.data()) + grad[grad.size() / 2]; });
+		run_bench(opt, results, "mc_area_grad_grid" + grid, cells, [&]() { return get_mc_area_grad_grid(p, n, n, n, grad.data()) + grad[grad.size() / 2]; });
+		run_bench(opt, results, "mc_vol_grad_grid_parallel" + grid, cells, [&]() {
+			return get_mc_vol_grad_grid_parallel(p, n, n, n, grad.data(), ThreadExecutor{ 1 }) + grad[grad.size() / 2];
+		});
+		run_bench(opt, results, "mc_area_grad_grid_parallel" + grid, cells, [&]() {
+			return get_mc_area_grad_grid_parallel(p, n, n, n, grad.data(), ThreadExecutor{ 1 }) + grad[grad.size() / 2];
+		});
+		//sixteen iso values, per iso value and cell
+		std::array<fType, 16> iso;
+		for (std::size_t m = 0; m < iso.size(); ++m) iso[m] = -0.2 + 0.025 * m;
+		run_bench(opt, results, "mc_grid_iso" + grid, cells * iso.size(), [&]() {
+			std::array<fType, iso.size()> vol, area;
+			get_mc_grid_iso(p, n, n, n, iso.data(), iType(iso.size()), vol.data(), area.data());
+			return vol[0] + vol[8] + area[0] + area[8];
+		});
+		//four fields offset from phi, interleaved, per field and cell
+		constexpr iType num_fields = 4;
+		std::vector<fType> interleaved(phi.size() * num_fields);
+		for (std::size_t n = 0; n < phi.size(); ++n)
+			for (iType f = 0; f < num_fields; ++f) interleaved[num_fields * n + f] = phi[n] + 0.01 * (f - 1);
+		const MCFields<fType> fields = get_mc_interleaved_fields(interleaved.data(), num_fields);
+		run_bench(opt, results, "mc_grid_fields" + grid, cells * num_fields, [&]() {
+			std::array<fType, num_fields> vol, area;
+			get_mc_grid_fields(fields, n, n, n, vol.data(), area.data());
+			return vol[0] + vol[3] + area[0] + area[3];
+		});
+		run_bench(opt, results, "mc_components" + grid, cells, [&]() {
+			const std::vector<MCComponent<fType>> components = get_mc_components(p, n, n, n, nullptr, ThreadExecutor{ 1 });
+			return double(components.size()) + (components.empty() ? 0.0 : components[0].vol);
+		});
+		//octree refined down to the grid spacing near the surface, per leaf
+		iType max_level = 0;
+		while ((iType(1) << max_level) < n) ++max_level;
+		MCOctree<fType> octree({ 0.0, 0.0, 0.0 }, 1.0, max_level);
+		octree.build(g.f, [&](iType, const std::array<fType, 3>& lo, const fType h) {
+			return std::abs(g.f(lo[0] + 0.5 * h, lo[1] + 0.5 * h, lo[2] + 0.5 * h)) < 1.8 * h;
+		});
+		const double leaves = double(octree.child.size() - (octree.child.size() - 1) / 8);
+		run_bench(opt, results, "mc_octree" + grid, leaves, [&]() {
+			fType vol, area;
+			get_mc_octree(octree, vol, area, ThreadExecutor{ 1 });
+			return vol + area;
+		});
+		//2 x 2 x 2 ranks as processes, including the fill of the owned nodes and the halo exchange
+		run_bench(opt, results, "mc_shards_local" + grid, cells, [&]() {
+			const MCBox nodes{ 0, 0, 0, n, n, n };
+			MCShardResult r;
+			get_mc_shards_local<fType>(n, n, n, 2, 2, 2, [&](const MCShard& s, fType* owned) { copy_mc_box_nodes(nodes, p, s.nodes, owned); }, r);
+			return r.vol.get() + r.area.get();
+		});
+		const MCSparseGrid<fType> sparse = make_bench_sparse_grid(p, n);
+		run_bench(opt, results, "mc_vol_grid_sparse" + grid, cells, [&]() { return get_mc_vol_grid(sparse); });
+		run_bench(opt, results, "mc_area_grid_sparse" + grid, cells, [&]() { return get_mc_area_grid(sparse); });
+		//one dirty region of 16^3 nodes per query, as after a local update of phi
+		MCTracker<fType> tracker(n, n, n);
+		tracker.update(p);
+		run_bench(opt, results, "mc_vol_grid_tracker" + grid, cells, [&]() {
+			tracker.mark(MCBox{ n / 2 - 8, n / 2 - 8, n / 2 - 8, n / 2 + 8, n / 2 + 8, n / 2 + 8 });
+			return tracker.get_vol(p);
+		});
+		//phi written to a raw file once; the stream reads it slice by slice on every run
+		const std::string raw = (std::filesystem::temp_directory_path() / "fraction_bench_stream.raw").string();
+		std::ofstream(raw, std::ios::binary).write(reinterpret_cast<const char*>(p), std::streamsize(phi.size() * sizeof(fType)));
+		run_bench(opt, results, "mc_grid_stream" + grid, cells, [&]() {
+			fType vol, area;
+			return get_mc_grid_stream<fType>(MCRawFile{ raw, n, n, n }, vol, area) ? vol + area : -1.0;
+		});
+		std::filesystem::remove(raw);
+
+		const iType m = 8 * n;
+		std::vector<fType> phi2d(std::size_t(m) * m);
+		for (iType j = 0; j < m; ++j)
+			for (iType i = 0; i < m; ++i) phi2d[i + std::size_t(m) * j] = g.f(fType(i) / m, 0.6, fType(j) / m);
+		const auto per_quad = [&](auto&& f) {
+			double sum = 0.0;
+			for (iType j = 0; j + 1 < m; ++j) {
+				const fType* r0 = phi2d.data() + std::size_t(m) * j;
+				const fType* r1 = r0 + m;
+				for (iType i = 0; i + 1 < m; ++i) sum += f(S4{ r0[i], r0[i + 1], r1[i + 1], r1[i] });
+			}
+			return sum;
+		};
+		const double quads = double(m - 1) * (m - 1);
+		run_bench(opt, results, "ms_area" + grid, quads, [&]() { return per_quad([](const S4& v) { return get_ms_area(v); }); });
+		run_bench(opt, results, "ms_len" + grid, quads, [&]() { return per_quad([](const S4& v) { return get_ms_len(v); }); });
+		run_bench(opt, results, "ms_image" + grid, quads, [&]() {
+			fType area, len;
+			get_ms_image(phi2d.data(), m, m, m, area, len, nullptr, nullptr, ThreadExecutor{ 1 });
+			return area + len;
+		});
+	}
+}
+
+//=================================================================================================
+//		json
+//=================================================================================================
+
+void write_json(const std::string& path, const BenchOptions& opt, const std::vector<BenchResult>& results)
+{
+	std::ofstream out(path);
+	out << "{\n  \"n\": " << opt.n << ",\n  \"runs\": " << opt.runs << ",\n  \"results\": [\n";
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		char line[256];
+		std::snprintf(line, sizeof(line), "    { \"name\": \"%s\", \"ns_per_cell\": %.4f, \"checksum\": %.17g }%s\n",
+			results[i].name.c_str(), results[i].ns_per_cell, results[i].checksum, i + 1 < results.size() ? "," : "");
+		out << line;
+	}
+	out << "  ]\n}\n";
+}
+
+//reads the "name"/"ns_per_cell" pairs written by write_json
+std::map<std::string, double> read_json(const std::string& path)
+{
+	std::ifstream in(path);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	const std::string s = ss.str();
+	std::map<std::string, double> times;
+	for (std::size_t p = s.find("\"name\""); p != std::string::npos; p = s.find("\"name\"", p + 1)) {
+		const std::size_t b = s.find('"', s.find(':', p) + 1) + 1;
+		const std::size_t e = s.find('"', b);
+		const std::size_t t = s.find("\"ns_per_cell\"", e);
+		if (t == std::string::npos) break;
+		times[s.substr(b, e - b)] = std::atof(s.c_str() + s.find(':', t) + 1);
+	}
+	return times;
+}
+
+//reports the results slower than the baseline by more than opt.tolerance and the results missing from it;
+//returns the number of them, or 1 if the baseline cannot be read or has no results
+int compare_baseline(const BenchOptions& opt, const std::vector<BenchResult>& results)
+{
+	const std::map<std::string, double> baseline = read_json(opt.baseline);
+	if (baseline.empty()) {
+		std::printf("cannot read baseline %s or it has no results\n", opt.baseline.c_str());
+		return 1;
+	}
+	int num_slower = 0, num_faster = 0, num_missing = 0, num_compared = 0;
+	double log_sum = 0.0;
+	for (const BenchResult& r : results) {
+		const auto it = baseline.find(r.name);
+		if (it == baseline.end() || it->second <= 0.0) {
+			std::printf("missing %-36s not in the baseline\n", r.name.c_str());
+			++num_missing;
+			continue;
+		}
+		const double ratio = r.ns_per_cell / it->second;
+		log_sum += std::log(ratio);
+		++num_compared;
+		if (ratio > 1.0 + opt.tolerance) {
+			std::printf("slower  %-36s %9.2f -> %9.2f ns/cell (%+.0f%%)\n", r.name.c_str(), it->second, r.ns_per_cell, 100.0 * (ratio - 1.0));
+			++num_slower;
+		}
+		else if (ratio < 1.0 / (1.0 + opt.tolerance)) {
+			++num_faster;
+		}
+	}
+	if (num_compared > 0) {
+		std::printf("compared %d results with %s: %d slower, %d faster than the tolerance %.0f%%, geometric mean ratio %.3f\n",
+			num_compared, opt.baseline.c_str(), num_slower, num_faster, 100.0 * opt.tolerance, std::exp(log_sum / num_compared));
+	}
+	if (num_missing > 0) std::printf("%d results missing from %s; regenerate it with --json\n", num_missing, opt.baseline.c_str());
+	return num_slower + num_missing;
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+int main(int argc, char** argv)
+{
+	BenchOptions opt;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (!std::strcmp(argv[i], "--n")) opt.n = std::max(2, std::atoi(argv[i + 1]));
+		else if (!std::strcmp(argv[i], "--runs")) opt.runs = std::max(1, std::atoi(argv[i + 1]));
+		else if (!std::strcmp(argv[i], "--filter")) opt.filter = argv[i + 1];
+		else if (!std::strcmp(argv[i], "--json")) opt.json = argv[i + 1];
+		else if (!std::strcmp(argv[i], "--baseline")) opt.baseline = argv[i + 1];
+		else if (!std::strcmp(argv[i], "--tolerance")) opt.tolerance = std::atof(argv[i + 1]);
+	}
+
+	if (!check_approx_error()) return 1;
+	std::vector<BenchResult> results;
+	bench_indices(opt, results);
+	bench_grids(opt, results);
+	if (!opt.json.empty()) write_json(opt.json, opt, results);
+	if (!opt.baseline.empty()) return compare_baseline(opt, results) != 0 ? 1 : 0;
+}
@@ -22,8 +22,28 @@ SOFTWARE.
 
 #ifndef FRACTION_HPP
 #define FRACTION_HPP
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#ifndef FRACTION_NO_EIGEN
 #include "Eigen/Dense"
+#endif
+#ifdef FRACTION_STATS
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#if defined(FRACTION_STATS_TIMING) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64))
+#include <x86intrin.h>
+#define FRACTION_STATS_RDTSC
+#endif
+#endif
 
 namespace Fraction
 {
@@ -38,9 +58,14 @@ using fType = double;
 using S4 = std::array<fType, 4>;
 using S6 = std::array<fType, 6>;
 using S8 = std::array<fType, 8>;
-using Vec3s = Eigen::Matrix<fType, 3, 1>;
-
+using S12 = std::array<fType, 12>;
 constexpr fType iso_value = 0.0;
+
+#ifndef FRACTION_NO_EIGEN
+template<typename T>
+using Vec3 = Eigen::Matrix<T, 3, 1>;
+using Vec3s = Vec3<fType>;
+
 const Vec3s v0(0.0, 0.0, 0.0);
 const Vec3s v1(1.0, 0.0, 0.0);
 const Vec3s v2(1.0, 1.0, 0.0);
@@ -49,22 +74,129 @@ const Vec3s v4(0.0, 0.0, 1.0);
 const Vec3s v5(1.0, 0.0, 1.0);
 const Vec3s v6(1.0, 1.0, 1.0);
 const Vec3s v7(0.0, 1.0, 1.0);
+#endif
 
 template<typename T>
 constexpr T square(const T x) { return x * x; }
 
-constexpr fType get_len_frac(fType a, fType b) {
-	if (a < 0 && b < 0) return 1.0;
+//=================================================================================================
+//		dual numbers
+//=================================================================================================
+
+//value and gradient with respect to N inputs (forward-mode differentiation). the kernels are templates
+//on the scalar type, so evaluating them on MCDual gives the exact derivatives of the same per-case formulas.
+//comparisons only look at the value, so the case decisions are those of the plain scalar evaluation
+template<typename T, std::size_t N>
+struct MCDual
+{
+	T value = T(0.0);
+	std::array<T, N> grad{};
+
+	constexpr MCDual() = default;
+	constexpr MCDual(const T value) : value(value) {}
+	constexpr MCDual(const T value, const std::array<T, N>& grad) : value(value), grad(grad) {}
+
+	//input i
+	static constexpr MCDual get_input(const T value, const std::size_t i)
+	{
+		MCDual x(value);
+		x.grad[i] = T(1.0);
+		return x;
+	}
+
+	constexpr MCDual operator-() const
+	{
+		MCDual r(-value);
+		for (std::size_t i = 0; i < N; ++i) r.grad[i] = -grad[i];
+		return r;
+	}
+	constexpr MCDual& operator+=(const MCDual& x)
+	{
+		value += x.value;
+		for (std::size_t i = 0; i < N; ++i) grad[i] += x.grad[i];
+		return *this;
+	}
+	constexpr MCDual& operator-=(const MCDual& x)
+	{
+		value -= x.value;
+		for (std::size_t i = 0; i < N; ++i) grad[i] -= x.grad[i];
+		return *this;
+	}
+	constexpr MCDual& operator*=(const MCDual& x)
+	{
+		for (std::size_t i = 0; i < N; ++i) grad[i] = grad[i] * x.value + value * x.grad[i];
+		value *= x.value;
+		return *this;
+	}
+	constexpr MCDual& operator/=(const MCDual& x)
+	{
+		value /= x.value;
+		for (std::size_t i = 0; i < N; ++i) grad[i] = (grad[i] - value * x.grad[i]) / x.value;
+		return *this;
+	}
+
+	friend constexpr MCDual operator+(MCDual a, const MCDual& b) { return a += b; }
+	friend constexpr MCDual operator-(MCDual a, const MCDual& b) { return a -= b; }
+	friend constexpr MCDual operator*(MCDual a, const MCDual& b) { return a *= b; }
+	friend constexpr MCDual operator/(MCDual a, const MCDual& b) { return a /= b; }
+	friend constexpr bool operator<(const MCDual& a, const MCDual& b) { return a.value < b.value; }
+	friend constexpr bool operator<=(const MCDual& a, const MCDual& b) { return a.value <= b.value; }
+	friend constexpr bool operator>(const MCDual& a, const MCDual& b) { return a.value > b.value; }
+	friend constexpr bool operator>=(const MCDual& a, const MCDual& b) { return a.value >= b.value; }
+
+	//the derivative of sqrt at 0 is taken as 0, e.g., for degenerate triangles
+	friend MCDual sqrt(const MCDual& x)
+	{
+		using std::sqrt;
+		MCDual r(sqrt(x.value));
+		if (r.value > T(0.0))
+			for (std::size_t i = 0; i < N; ++i) r.grad[i] = x.grad[i] / (T(2.0) * r.value);
+		return r;
+	}
+};
+
+//comparisons with plain numbers (e.g., a < 0 in get_len_frac)
+template<typename T, std::size_t N, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+constexpr bool operator<(const MCDual<T, N>& a, const U b) { return a.value < b; }
+
+template<typename T, std::size_t N, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+constexpr bool operator<(const U a, const MCDual<T, N>& b) { return a < b.value; }
+
+template<typename T, std::size_t N, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+constexpr bool operator<=(const MCDual<T, N>& a, const U b) { return a.value <= b; }
+
+template<typename T, std::size_t N, typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+constexpr bool operator<=(const U a, const MCDual<T, N>& b) { return a <= b.value; }
+
+template<typename T>
+constexpr bool is_mc_dual = false;
+
+template<typename T, std::size_t N>
+constexpr bool is_mc_dual<MCDual<T, N>> = true;
+
+//scalar types of the kernels
+template<typename T>
+constexpr bool is_mc_scalar = std::is_floating_point_v<T> || is_mc_dual<T>;
+
+template<typename T>
+constexpr T get_len_frac(const T a, const T b) {
+	if (a < 0 && b < 0) return T(1.0);
 	if (a < 0 && 0 <= b) return a / (a - b);
 	if (0 <= a && b < 0) return b / (b - a);
-	return 0;
+	return T(0.0);
 }
 
+//edge fractions are symmetric, get_len_frac(a, b) == get_len_frac(b, a),
+//so a cell can be described either by its corner values (S8) or by its 12 edge fractions (S12)
+template<iType A, iType B, typename T>
+constexpr T get_len_frac(const std::array<T, 8>& v) { return get_len_frac(v[A], v[B]); }
+
 //=================================================================================================
 //		ms-style
 //=================================================================================================
 
-constexpr iType get_ms_table_index(const S4& v)
+template<typename T>
+constexpr iType get_ms_table_index(const std::array<T, 4>& v)
 {
 	iType table_index = 0;
 	if (v[0] < iso_value) table_index |= 1;
@@ -74,71 +206,132 @@ constexpr iType get_ms_table_index(const S4& v)
 	return table_index;
 }
 
-constexpr fType get_ms_area(const S4& v)
+template<typename T = fType>
+constexpr T get_ms_area(const std::array<T, 4>& v)
 {
-	const auto get_split_case = [](const S4& v) {
+	const auto get_split_case = [](const std::array<T, 4>& v) {
 		if (v[0] + v[1] + v[2] + v[3] < 0) {
-			return 1.0 - 0.5 * (
-				((1.0 - get_len_frac(v[0], v[1])) * (1.0 - get_len_frac(v[1], v[2]))) +
-				((1.0 - get_len_frac(v[3], v[0])) * (1.0 - get_len_frac(v[3], v[2]))));
+			return T(1.0) - T(0.5) * (
+				((T(1.0) - get_len_frac(v[0], v[1])) * (T(1.0) - get_len_frac(v[1], v[2]))) +
+				((T(1.0) - get_len_frac(v[3], v[0])) * (T(1.0) - get_len_frac(v[3], v[2]))));
 		}
 		else {
-			return 0.5 * (get_len_frac(v[0], v[1]) * get_len_frac(v[0], v[3]) + get_len_frac(v[2], v[1]) * get_len_frac(v[2], v[3]));
+			return T(0.5) * (get_len_frac(v[0], v[1]) * get_len_frac(v[0], v[3]) + get_len_frac(v[2], v[1]) * get_len_frac(v[2], v[3]));
 		}
 	};
 	switch (const iType table_index = get_ms_table_index(v); table_index) {
-	case 0: return 0.0;
-	case 1: return 0.5 * get_len_frac(v[0], v[1]) * get_len_frac(v[0], v[3]);
-	case 2: return 0.5 * get_len_frac(v[1], v[0]) * get_len_frac(v[1], v[2]);
-	case 3: return 0.5 * (get_len_frac(v[0], v[3]) + get_len_frac(v[1], v[2]));
-	case 4: return 0.5 * get_len_frac(v[2], v[1]) * get_len_frac(v[2], v[3]);
+	case 0: return T(0.0);
+	case 1: return T(0.5) * get_len_frac(v[0], v[1]) * get_len_frac(v[0], v[3]);
+	case 2: return T(0.5) * get_len_frac(v[1], v[0]) * get_len_frac(v[1], v[2]);
+	case 3: return T(0.5) * (get_len_frac(v[0], v[3]) + get_len_frac(v[1], v[2]));
+	case 4: return T(0.5) * get_len_frac(v[2], v[1]) * get_len_frac(v[2], v[3]);
 	case 5: return get_split_case(v);
-	case 6: return 0.5 * (get_len_frac(v[1], v[0]) + get_len_frac(v[2], v[3]));
-	case 7: return 1.0 - 0.5 * (1.0 - get_len_frac(v[0], v[3])) * (1.0 - get_len_frac(v[2], v[3]));
-	case 8: return 0.5 * get_len_frac(v[0], v[3]) * get_len_frac(v[2], v[3]);
-	case 9: return 0.5 * (get_len_frac(v[0], v[1]) + get_len_frac(v[3], v[2]));
+	case 6: return T(0.5) * (get_len_frac(v[1], v[0]) + get_len_frac(v[2], v[3]));
+	case 7: return T(1.0) - T(0.5) * (T(1.0) - get_len_frac(v[0], v[3])) * (T(1.0) - get_len_frac(v[2], v[3]));
+	case 8: return T(0.5) * get_len_frac(v[0], v[3]) * get_len_frac(v[2], v[3]);
+	case 9: return T(0.5) * (get_len_frac(v[0], v[1]) + get_len_frac(v[3], v[2]));
 	case 10: return get_split_case({ v[1], v[2], v[3], v[0] });
-	case 11: return 1.0 - 0.5 * (1.0 - get_len_frac(v[1], v[2])) * (1.0 - get_len_frac(v[2], v[3]));
-	case 12: return 0.5 * (get_len_frac(v[0], v[3]) + get_len_frac(v[2], v[1]));
-	case 13: return 1.0 - 0.5 * (1.0 - get_len_frac(v[0], v[1])) * (1.0 - get_len_frac(v[1], v[2]));
-	case 14: return 1.0 - 0.5 * (1.0 - get_len_frac(v[0], v[1])) * (1.0 - get_len_frac(v[0], v[3]));
-	case 15: return 1.0;
-	default: return 0.0;//dummy
+	case 11: return T(1.0) - T(0.5) * (T(1.0) - get_len_frac(v[1], v[2])) * (T(1.0) - get_len_frac(v[2], v[3]));
+	case 12: return T(0.5) * (get_len_frac(v[0], v[3]) + get_len_frac(v[2], v[1]));
+	case 13: return T(1.0) - T(0.5) * (T(1.0) - get_len_frac(v[0], v[1])) * (T(1.0) - get_len_frac(v[1], v[2]));
+	case 14: return T(1.0) - T(0.5) * (T(1.0) - get_len_frac(v[0], v[1])) * (T(1.0) - get_len_frac(v[0], v[3]));
+	case 15: return T(1.0);
+	default: return T(0.0);//dummy
 	}
 }
 
-constexpr fType get_ms_len(const S4& v)
+template<typename T = fType>
+constexpr T get_ms_len(const std::array<T, 4>& v)
 {
-	const auto get_split_case = [](const S4& v) {
+	using std::sqrt;
+	const auto get_split_case = [](const std::array<T, 4>& v) {
 		if (v[0] + v[1] + v[2] + v[3] < 0) {
 			return
-				std::sqrt(square(1.0 - get_len_frac(v[0], v[1])) + square(1.0 - get_len_frac(v[1], v[2]))) +
-				std::sqrt(square(1.0 - get_len_frac(v[3], v[0])) + square(1.0 - get_len_frac(v[3], v[2])));
+				sqrt(square(T(1.0) - get_len_frac(v[0], v[1])) + square(T(1.0) - get_len_frac(v[1], v[2]))) +
+				sqrt(square(T(1.0) - get_len_frac(v[3], v[0])) + square(T(1.0) - get_len_frac(v[3], v[2])));
 		}
 		else {
 			return
-				std::sqrt(square(get_len_frac(v[0], v[1])) + square(get_len_frac(v[0], v[3]))) +
-				std::sqrt(square(get_len_frac(v[2], v[1])) + square(get_len_frac(v[2], v[3])));
+				sqrt(square(get_len_frac(v[0], v[1])) + square(get_len_frac(v[0], v[3]))) +
+				sqrt(square(get_len_frac(v[2], v[1])) + square(get_len_frac(v[2], v[3])));
 		}
 	};
 	switch (const iType table_index = get_ms_table_index(v); table_index) {
-	case 0: return 0.0;
-	case 1: return std::sqrt(square(get_len_frac(v[0], v[1])) + square(get_len_frac(v[0], v[3])));
-	case 2: return std::sqrt(square(get_len_frac(v[1], v[0])) + square(get_len_frac(v[1], v[2])));
-	case 3: return std::sqrt(1.0 + square(get_len_frac(v[0], v[3]) - get_len_frac(v[1], v[2])));
-	case 4: return std::sqrt(square(get_len_frac(v[2], v[1])) + square(get_len_frac(v[2], v[3])));
+	case 0: return T(0.0);
+	case 1: return sqrt(square(get_len_frac(v[0], v[1])) + square(get_len_frac(v[0], v[3])));
+	case 2: return sqrt(square(get_len_frac(v[1], v[0])) + square(get_len_frac(v[1], v[2])));
+	case 3: return sqrt(T(1.0) + square(get_len_frac(v[0], v[3]) - get_len_frac(v[1], v[2])));
+	case 4: return sqrt(square(get_len_frac(v[2], v[1])) + square(get_len_frac(v[2], v[3])));
 	case 5: return get_split_case(v);
-	case 6: return std::sqrt(1.0 + square(get_len_frac(v[1], v[0]) - get_len_frac(v[2], v[3])));
-	case 7: return std::sqrt(square(1.0 - get_len_frac(v[0], v[3])) + square(1.0 - get_len_frac(v[2], v[3])));
-	case 8: return std::sqrt(square(get_len_frac(v[0], v[3])) + square(get_len_frac(v[2], v[3])));
-	case 9: return std::sqrt(1.0 + square(get_len_frac(v[0], v[1]) - get_len_frac(v[3], v[2])));
+	case 6: return sqrt(T(1.0) + square(get_len_frac(v[1], v[0]) - get_len_frac(v[2], v[3])));
+	case 7: return sqrt(square(T(1.0) - get_len_frac(v[0], v[3])) + square(T(1.0) - get_len_frac(v[2], v[3])));
+	case 8: return sqrt(square(get_len_frac(v[0], v[3])) + square(get_len_frac(v[2], v[3])));
+	case 9: return sqrt(T(1.0) + square(get_len_frac(v[0], v[1]) - get_len_frac(v[3], v[2])));
 	case 10: return get_split_case({ v[1], v[2], v[3], v[0] });
-	case 11: return std::sqrt(square(1.0 - get_len_frac(v[1], v[2])) + square(1.0 - get_len_frac(v[2], v[3])));
-	case 12: return std::sqrt(1.0 + square(get_len_frac(v[0], v[3]) - get_len_frac(v[2], v[1])));
-	case 13: return std::sqrt(square(1.0 - get_len_frac(v[0], v[1])) + square(1.0 - get_len_frac(v[1], v[2])));
-	case 14: return std::sqrt(square(1.0 - get_len_frac(v[0], v[1])) + square(1.0 - get_len_frac(v[0], v[3])));
-	case 15: return 0.0;
-	default: return 0.0;//dummy
+	case 11: return sqrt(square(T(1.0) - get_len_frac(v[1], v[2])) + square(T(1.0) - get_len_frac(v[2], v[3])));
+	case 12: return sqrt(T(1.0) + square(get_len_frac(v[0], v[3]) - get_len_frac(v[2], v[1])));
+	case 13: return sqrt(square(T(1.0) - get_len_frac(v[0], v[1])) + square(T(1.0) - get_len_frac(v[1], v[2])));
+	case 14: return sqrt(square(T(1.0) - get_len_frac(v[0], v[1])) + square(T(1.0) - get_len_frac(v[0], v[3])));
+	case 15: return T(0.0);
+	default: return T(0.0);//dummy
+	}
+}
+
+//the same kernels on the edge fractions e of the edges (0, 1), (1, 2), (2, 3), and (3, 0) of the quad,
+//so that an edge shared by two quads is computed once. negative is v[0] + v[1] + v[2] + v[3] < 0,
+//which selects the split of the cases 5 and 10, and only matters for them
+template<typename T = fType>
+constexpr T get_ms_area(const iType table_index, const std::array<T, 4>& e, const bool negative)
+{
+	switch (table_index) {
+	case 0: return T(0.0);
+	case 1: return T(0.5) * e[0] * e[3];
+	case 2: return T(0.5) * e[0] * e[1];
+	case 3: return T(0.5) * (e[3] + e[1]);
+	case 4: return T(0.5) * e[1] * e[2];
+	case 5: return negative ? T(1.0) - T(0.5) * (((T(1.0) - e[0]) * (T(1.0) - e[1])) + ((T(1.0) - e[3]) * (T(1.0) - e[2]))) :
+		T(0.5) * (e[0] * e[3] + e[1] * e[2]);
+	case 6: return T(0.5) * (e[0] + e[2]);
+	case 7: return T(1.0) - T(0.5) * (T(1.0) - e[3]) * (T(1.0) - e[2]);
+	case 8: return T(0.5) * e[3] * e[2];
+	case 9: return T(0.5) * (e[0] + e[2]);
+	case 10: return negative ? T(1.0) - T(0.5) * (((T(1.0) - e[1]) * (T(1.0) - e[2])) + ((T(1.0) - e[0]) * (T(1.0) - e[3]))) :
+		T(0.5) * (e[1] * e[0] + e[2] * e[3]);
+	case 11: return T(1.0) - T(0.5) * (T(1.0) - e[1]) * (T(1.0) - e[2]);
+	case 12: return T(0.5) * (e[3] + e[1]);
+	case 13: return T(1.0) - T(0.5) * (T(1.0) - e[0]) * (T(1.0) - e[1]);
+	case 14: return T(1.0) - T(0.5) * (T(1.0) - e[0]) * (T(1.0) - e[3]);
+	case 15: return T(1.0);
+	default: return T(0.0);//dummy
+	}
+}
+
+template<typename T = fType>
+constexpr T get_ms_len(const iType table_index, const std::array<T, 4>& e, const bool negative)
+{
+	using std::sqrt;
+	switch (table_index) {
+	case 0: return T(0.0);
+	case 1: return sqrt(square(e[0]) + square(e[3]));
+	case 2: return sqrt(square(e[0]) + square(e[1]));
+	case 3: return sqrt(T(1.0) + square(e[3] - e[1]));
+	case 4: return sqrt(square(e[1]) + square(e[2]));
+	case 5: return negative ?
+		sqrt(square(T(1.0) - e[0]) + square(T(1.0) - e[1])) + sqrt(square(T(1.0) - e[3]) + square(T(1.0) - e[2])) :
+		sqrt(square(e[0]) + square(e[3])) + sqrt(square(e[1]) + square(e[2]));
+	case 6: return sqrt(T(1.0) + square(e[0] - e[2]));
+	case 7: return sqrt(square(T(1.0) - e[3]) + square(T(1.0) - e[2]));
+	case 8: return sqrt(square(e[3]) + square(e[2]));
+	case 9: return sqrt(T(1.0) + square(e[0] - e[2]));
+	case 10: return negative ?
+		sqrt(square(T(1.0) - e[1]) + square(T(1.0) - e[2])) + sqrt(square(T(1.0) - e[0]) + square(T(1.0) - e[3])) :
+		sqrt(square(e[1]) + square(e[0])) + sqrt(square(e[2]) + square(e[3]));
+	case 11: return sqrt(square(T(1.0) - e[1]) + square(T(1.0) - e[2]));
+	case 12: return sqrt(T(1.0) + square(e[3] - e[1]));
+	case 13: return sqrt(square(T(1.0) - e[0]) + square(T(1.0) - e[1]));
+	case 14: return sqrt(square(T(1.0) - e[0]) + square(T(1.0) - e[3]));
+	case 15: return T(0.0);
+	default: return T(0.0);//dummy
 	}
 }
 
@@ -146,7 +339,8 @@ constexpr fType get_ms_len(const S4& v)
 //		mc-style
 //=================================================================================================
 
-constexpr iType get_mc_table_index(const S8& v)
+template<typename T>
+constexpr iType get_mc_table_index(const std::array<T, 8>& v)
 {
 	iType table_index = 0;
 	if (v[0] < iso_value) table_index |= 1;
@@ -190,100 +384,344 @@ constexpr std::array<T, 8> get_rotated_vals(const std::array<T, 8>& v)
 	return v; //dummy
 }
 
-template<iType N, bool inside>
-constexpr Vec3s get_e(const S8& v)
+//corner pairs of e0, ..., e11 (same numbering as get_e)
+constexpr std::array<std::array<iType, 2>, 12> mc_edges{ {
+	{ 0, 1 }, { 1, 2 }, { 2, 3 }, { 0, 3 }, { 4, 5 }, { 5, 6 }, { 6, 7 }, { 4, 7 },
+	{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } } };
+
+//corner positions of the cell (same order as S8)
+constexpr std::array<std::array<iType, 3>, 8> mc_corners{ {
+	{ 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } } };
+
+constexpr iType get_mc_edge_index(const iType a, const iType b)
+{
+	for (iType i = 0; i < 12; ++i) {
+		if ((mc_edges[i][0] == a && mc_edges[i][1] == b) || (mc_edges[i][0] == b && mc_edges[i][1] == a)) return i;
+	}
+	return -1;
+}
+
+template<iType A, iType B, typename T>
+constexpr T get_len_frac(const std::array<T, 12>& e)
+{
+	constexpr iType i = get_mc_edge_index(A, B);
+	static_assert(i >= 0, "not an edge of the cell");
+	return e[i];
+}
+
+//edge i of the rotated cell is edge get_mc_rotated_edges<N>()[i] of the original cell
+template<iType N>
+constexpr std::array<iType, 12> get_mc_rotated_edges()
+{
+	constexpr std::array<iType, 8> p = get_rotated_vals<iType, N>(std::array<iType, 8>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+	std::array<iType, 12> r{};
+	for (iType i = 0; i < 12; ++i) r[i] = get_mc_edge_index(p[mc_edges[i][0]], p[mc_edges[i][1]]);
+	return r;
+}
+
+template<iType N>
+constexpr std::array<iType, 12> mc_rotated_edges = get_mc_rotated_edges<N>();
+
+template<typename T, iType N>
+constexpr std::array<T, 12> get_rotated_vals(const std::array<T, 12>& e)
+{
+	constexpr const std::array<iType, 12>& r = mc_rotated_edges<N>;
+	return { e[r[0]], e[r[1]], e[r[2]], e[r[3]], e[r[4]], e[r[5]], e[r[6]], e[r[7]], e[r[8]], e[r[9]], e[r[10]], e[r[11]] };
+}
+
+//backends of the triangle terms in the mc case kernels.
+//EigenBackend evaluates them with Eigen vectors. ScalarBackend expands them into scalar expressions
+//in which the constant 0/1 coordinates of the cell corners are folded at compile time.
+//define FRACTION_NO_EIGEN to use ScalarBackend by default and to compile without Eigen
+struct EigenBackend {};
+struct ScalarBackend {};
+
+#ifdef FRACTION_NO_EIGEN
+using MCBackend = ScalarBackend;
+#else
+using MCBackend = EigenBackend;
+#endif
+
+//compile-time constant K: products and sums with a runtime value x reduce to x, -x, or MCConst where possible
+template<iType K>
+struct MCConst {};
+
+constexpr MCConst<0> mc_zero;
+constexpr MCConst<1> mc_one;
+
+template<typename T>
+constexpr T get_mc_value(const T x) { return x; }
+
+template<typename T, iType K>
+constexpr T get_mc_value(MCConst<K>) { return T(K); }
+
+template<iType A, iType B>
+constexpr MCConst<A + B> operator+(MCConst<A>, MCConst<B>) { return {}; }
+
+template<iType A, iType B>
+constexpr MCConst<A - B> operator-(MCConst<A>, MCConst<B>) { return {}; }
+
+template<iType A, iType B>
+constexpr MCConst<A * B> operator*(MCConst<A>, MCConst<B>) { return {}; }
+
+template<iType K>
+constexpr MCConst<-K> operator-(MCConst<K>) { return {}; }
+
+template<typename T>
+using EnableIfScalar = std::enable_if_t<is_mc_scalar<T>, int>;
+
+template<iType K, typename T, EnableIfScalar<T> = 0>
+constexpr auto operator+(MCConst<K>, const T x)
+{
+	if constexpr (K == 0) return x;
+	else return T(K) + x;
+}
+
+template<iType K, typename T, EnableIfScalar<T> = 0>
+constexpr auto operator+(const T x, MCConst<K>)
+{
+	if constexpr (K == 0) return x;
+	else return x + T(K);
+}
+
+template<iType K, typename T, EnableIfScalar<T> = 0>
+constexpr auto operator-(MCConst<K>, const T x)
+{
+	if constexpr (K == 0) return -x;
+	else return T(K) - x;
+}
+
+template<iType K, typename T, EnableIfScalar<T> = 0>
+constexpr auto operator-(const T x, MCConst<K>)
+{
+	if constexpr (K == 0) return x;
+	else return x - T(K);
+}
+
+template<iType K, typename T, EnableIfScalar<T> = 0>
+constexpr auto operator*(MCConst<K>, const T x)
+{
+	if constexpr (K == 0) return MCConst<0>();
+	else if constexpr (K == 1) return x;
+	else if constexpr (K == -1) return -x;
+	else return T(K) * x;
+}
+
+template<iType K, typename T, EnableIfScalar<T> = 0>
+constexpr auto operator*(const T x, MCConst<K>)
+{
+	if constexpr (K == 0) return MCConst<0>();
+	else if constexpr (K == 1) return x;
+	else if constexpr (K == -1) return -x;
+	else return x * T(K);
+}
+
+//point whose coordinates are runtime values or MCConst
+template<typename X, typename Y, typename Z>
+struct MCPoint
+{
+	X x;
+	Y y;
+	Z z;
+};
+
+template<typename X, typename Y, typename Z>
+constexpr MCPoint<X, Y, Z> make_mc_point(const X x, const Y y, const Z z) { return { x, y, z }; }
+
+template<typename X0, typename Y0, typename Z0, typename X1, typename Y1, typename Z1>
+constexpr auto operator-(const MCPoint<X0, Y0, Z0>& a, const MCPoint<X1, Y1, Z1>& b)
+{
+	return make_mc_point(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+template<typename X0, typename Y0, typename Z0, typename X1, typename Y1, typename Z1>
+constexpr auto get_mc_cross(const MCPoint<X0, Y0, Z0>& a, const MCPoint<X1, Y1, Z1>& b)
+{
+	return make_mc_point(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+template<typename X0, typename Y0, typename Z0, typename X1, typename Y1, typename Z1>
+constexpr auto get_mc_dot(const MCPoint<X0, Y0, Z0>& a, const MCPoint<X1, Y1, Z1>& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template<typename T, typename X, typename Y, typename Z>
+constexpr T get_mc_norm(const MCPoint<X, Y, Z>& a)
+{
+	using std::sqrt;
+	return sqrt(get_mc_value<T>(get_mc_dot(a, a)));
+}
+
+template<typename T, typename X, typename Y, typename Z>
+constexpr MCPoint<X, Y, Z> get_mc_point(ScalarBackend, const X x, const Y y, const Z z) { return { x, y, z }; }
+
+#ifndef FRACTION_NO_EIGEN
+template<typename T, typename X, typename Y, typename Z>
+constexpr Vec3<T> get_mc_point(EigenBackend, const X x, const Y y, const Z z)
+{
+	return Vec3<T>(get_mc_value<T>(x), get_mc_value<T>(y), get_mc_value<T>(z));
+}
+
+template<typename D0, typename D1>
+constexpr auto get_mc_cross(const Eigen::MatrixBase<D0>& a, const Eigen::MatrixBase<D1>& b) { return a.cross(b); }
+
+template<typename D0, typename D1>
+constexpr auto get_mc_dot(const Eigen::MatrixBase<D0>& a, const Eigen::MatrixBase<D1>& b) { return a.dot(b); }
+
+template<typename T, typename D>
+constexpr T get_mc_norm(const Eigen::MatrixBase<D>& a) { return a.norm(); }
+#endif
+
+//cell spacing. the kernels work on the unit cube (MCUnitSpacing). an isotropic spacing h scales
+//the volume by h^3 and the area by h^2. under an anisotropic spacing (dx, dy, dz), the volume scales
+//by dx dy dz, but the normal n of a surface triangle in cell coordinates becomes (dy dz n_x, dx dz n_y, dx dy n_z)
+//in world space, so the area kernels weight the normals with these cofactors (MCAreaWeights)
+struct MCUnitSpacing {};
+
+template<typename T = fType>
+struct MCIsoSpacing
+{
+	T h = T(1.0);
+};
+
+template<typename T = fType>
+struct MCSpacing
+{
+	T dx = T(1.0), dy = T(1.0), dz = T(1.0);
+};
+
+//cofactors of the spacing along the axes of a (rotated) cell
+template<typename T>
+struct MCAreaWeights
 {
+	T x, y, z;
+};
+
+template<typename P>
+constexpr const P& get_mc_weighted(MCUnitSpacing, const P& n) { return n; }
+
+template<typename T, typename X, typename Y, typename Z>
+constexpr auto get_mc_weighted(const MCAreaWeights<T>& w, const MCPoint<X, Y, Z>& n) { return make_mc_point(n.x * w.x, n.y * w.y, n.z * w.z); }
+
+#ifndef FRACTION_NO_EIGEN
+template<typename T, typename D>
+constexpr Vec3<T> get_mc_weighted(const MCAreaWeights<T>& w, const Eigen::MatrixBase<D>& n)
+{
+	return Vec3<T>(n.x() * w.x, n.y() * w.y, n.z() * w.z);
+}
+#endif
+
+template<iType N, bool inside, typename B = MCBackend, typename V>
+constexpr auto get_e(const V& v)
+{
+	using T = typename V::value_type;
 	if constexpr (inside) {
-		if constexpr (N == 0) return Vec3s(get_len_frac(v[0], v[1]), 0.0, 0.0);
-		else if constexpr (N == 1) return Vec3s(1.0, get_len_frac(v[1], v[2]), 0.0);
-		else if constexpr (N == 2) return Vec3s(get_len_frac(v[2], v[3]), 1.0, 0.0);
-		else if constexpr (N == 3) return Vec3s(0.0, get_len_frac(v[0], v[3]), 0.0);
-		else if constexpr (N == 4) return Vec3s(get_len_frac(v[4], v[5]), 0.0, 1.0);
-		else if constexpr (N == 5) return Vec3s(1.0, get_len_frac(v[5], v[6]), 1.0);
-		else if constexpr (N == 6) return Vec3s(get_len_frac(v[6], v[7]), 1.0, 1.0);
-		else if constexpr (N == 7) return Vec3s(0.0, get_len_frac(v[4], v[7]), 1.0);
-		else if constexpr (N == 8) return Vec3s(0.0, 0.0, get_len_frac(v[0], v[4]));
-		else if constexpr (N == 9) return Vec3s(1.0, 0.0, get_len_frac(v[1], v[5]));
-		else if constexpr (N == 10) return Vec3s(1.0, 1.0, get_len_frac(v[2], v[6]));
-		else if constexpr (N == 11) return Vec3s(0.0, 1.0, get_len_frac(v[3], v[7]));
+		if constexpr (N == 0) return get_mc_point<T>(B(), get_len_frac<0, 1>(v), mc_zero, mc_zero);
+		else if constexpr (N == 1) return get_mc_point<T>(B(), mc_one, get_len_frac<1, 2>(v), mc_zero);
+		else if constexpr (N == 2) return get_mc_point<T>(B(), get_len_frac<2, 3>(v), mc_one, mc_zero);
+		else if constexpr (N == 3) return get_mc_point<T>(B(), mc_zero, get_len_frac<0, 3>(v), mc_zero);
+		else if constexpr (N == 4) return get_mc_point<T>(B(), get_len_frac<4, 5>(v), mc_zero, mc_one);
+		else if constexpr (N == 5) return get_mc_point<T>(B(), mc_one, get_len_frac<5, 6>(v), mc_one);
+		else if constexpr (N == 6) return get_mc_point<T>(B(), get_len_frac<6, 7>(v), mc_one, mc_one);
+		else if constexpr (N == 7) return get_mc_point<T>(B(), mc_zero, get_len_frac<4, 7>(v), mc_one);
+		else if constexpr (N == 8) return get_mc_point<T>(B(), mc_zero, mc_zero, get_len_frac<0, 4>(v));
+		else if constexpr (N == 9) return get_mc_point<T>(B(), mc_one, mc_zero, get_len_frac<1, 5>(v));
+		else if constexpr (N == 10) return get_mc_point<T>(B(), mc_one, mc_one, get_len_frac<2, 6>(v));
+		else if constexpr (N == 11) return get_mc_point<T>(B(), mc_zero, mc_one, get_len_frac<3, 7>(v));
 	}
 	else if constexpr (!inside) {
-		if constexpr (N == 0) return Vec3s(1.0 - get_len_frac(v[0], v[1]), 0.0, 0.0);
-		else if constexpr (N == 1) return Vec3s(1.0, 1.0 - get_len_frac(v[1], v[2]), 0.0);
-		else if constexpr (N == 2) return Vec3s(1.0 - get_len_frac(v[2], v[3]), 1.0, 0.0);
-		else if constexpr (N == 3) return Vec3s(0.0, 1.0 - get_len_frac(v[0], v[3]), 0.0);
-		else if constexpr (N == 4) return Vec3s(1.0 - get_len_frac(v[4], v[5]), 0.0, 1.0);
-		else if constexpr (N == 5) return Vec3s(1.0, 1.0 - get_len_frac(v[5], v[6]), 1.0);
-		else if constexpr (N == 6) return Vec3s(1.0 - get_len_frac(v[6], v[7]), 1.0, 1.0);
-		else if constexpr (N == 7) return Vec3s(0.0, 1.0 - get_len_frac(v[4], v[7]), 1.0);
-		else if constexpr (N == 8) return Vec3s(0.0, 0.0, 1.0 - get_len_frac(v[0], v[4]));
-		else if constexpr (N == 9) return Vec3s(1.0, 0.0, 1.0 - get_len_frac(v[1], v[5]));
-		else if constexpr (N == 10) return Vec3s(1.0, 1.0, 1.0 - get_len_frac(v[2], v[6]));
-		else if constexpr (N == 11) return Vec3s(0.0, 1.0, 1.0 - get_len_frac(v[3], v[7]));
-	}
-	return v0;//dummy
-}
-
-template<iType N, iType M = 0>
-constexpr fType get_mc_vol_case(const S8& v)
-{
-	constexpr fType scale = 1.0 / 6.0;
-	const auto sv = [](const Vec3s& v0, const Vec3s& v1, const Vec3s& v2) {//signed vol
-		return ((v1 - v0).cross(v0 - v2)).dot(v0);
-	};
-	const auto pattern1 = [](const S4& v) {
-		return get_len_frac(v[0], v[1]) * get_len_frac(v[0], v[2]) * get_len_frac(v[0], v[3]);
-	};
-	const auto pattern2 = [](const S6& v) {
-		const fType e1 = get_len_frac(v[3], v[4]);
-		return ((get_len_frac(v[0], v[1]) + e1) * get_len_frac(v[1], v[2]) + (e1 * get_len_frac(v[4], v[5])));
-	};
-	const auto pattern21 = [](const S4& v) {
-		return (1.0 - get_len_frac(v[0], v[1])) * (1.0 - get_len_frac(v[0], v[2])) * (1.0 - get_len_frac(v[0], v[3]));
+		if constexpr (N == 0) return get_mc_point<T>(B(), T(1.0) - get_len_frac<0, 1>(v), mc_zero, mc_zero);
+		else if constexpr (N == 1) return get_mc_point<T>(B(), mc_one, T(1.0) - get_len_frac<1, 2>(v), mc_zero);
+		else if constexpr (N == 2) return get_mc_point<T>(B(), T(1.0) - get_len_frac<2, 3>(v), mc_one, mc_zero);
+		else if constexpr (N == 3) return get_mc_point<T>(B(), mc_zero, T(1.0) - get_len_frac<0, 3>(v), mc_zero);
+		else if constexpr (N == 4) return get_mc_point<T>(B(), T(1.0) - get_len_frac<4, 5>(v), mc_zero, mc_one);
+		else if constexpr (N == 5) return get_mc_point<T>(B(), mc_one, T(1.0) - get_len_frac<5, 6>(v), mc_one);
+		else if constexpr (N == 6) return get_mc_point<T>(B(), T(1.0) - get_len_frac<6, 7>(v), mc_one, mc_one);
+		else if constexpr (N == 7) return get_mc_point<T>(B(), mc_zero, T(1.0) - get_len_frac<4, 7>(v), mc_one);
+		else if constexpr (N == 8) return get_mc_point<T>(B(), mc_zero, mc_zero, T(1.0) - get_len_frac<0, 4>(v));
+		else if constexpr (N == 9) return get_mc_point<T>(B(), mc_one, mc_zero, T(1.0) - get_len_frac<1, 5>(v));
+		else if constexpr (N == 10) return get_mc_point<T>(B(), mc_one, mc_one, T(1.0) - get_len_frac<2, 6>(v));
+		else if constexpr (N == 11) return get_mc_point<T>(B(), mc_zero, mc_one, T(1.0) - get_len_frac<3, 7>(v));
+	}
+}
+
+template<iType A, iType B, iType C, iType D, typename V>
+constexpr typename V::value_type mc_pattern1(const V& v)
+{
+	return get_len_frac<A, B>(v) * get_len_frac<A, C>(v) * get_len_frac<A, D>(v);
+}
+
+template<iType A, iType B, iType C, iType D, iType E, iType F, typename V>
+constexpr typename V::value_type mc_pattern2(const V& v)
+{
+	using T = typename V::value_type;
+	const T e1 = get_len_frac<D, E>(v);
+	return ((get_len_frac<A, B>(v) + e1) * get_len_frac<B, C>(v) + (e1 * get_len_frac<E, F>(v)));
+}
+
+template<iType A, iType B, iType C, iType D, typename V>
+constexpr typename V::value_type mc_pattern21(const V& v)
+{
+	using T = typename V::value_type;
+	return (T(1.0) - get_len_frac<A, B>(v)) * (T(1.0) - get_len_frac<A, C>(v)) * (T(1.0) - get_len_frac<A, D>(v));
+}
+
+template<iType N, iType M = 0, typename B = MCBackend, typename V>
+constexpr typename V::value_type get_mc_vol_case(const V& v)
+{
+	using T = typename V::value_type;
+	constexpr T scale = T(1.0) / T(6.0);
+	const auto sv = [](const auto& v0, const auto& v1, const auto& v2) {//signed vol
+		return get_mc_value<T>(get_mc_dot(get_mc_cross(v1 - v0, v0 - v2), v0));
 	};
 
 	if constexpr (N == 0) {
-		return 0.0;
+		return T(0.0);
 	}
 	else if constexpr (N == 1) {
-		return scale * pattern1({ v[0], v[1], v[3], v[4] });
+		return scale * mc_pattern1<0, 1, 3, 4>(v);
 	}
 	else if constexpr (N == 2) {
-		return scale * pattern2({ v[3], v[0], v[4], v[2], v[1], v[5] });
+		return scale * mc_pattern2<3, 0, 4, 2, 1, 5>(v);
 	}
 	else if constexpr (N == 3) {
-		return scale * (pattern1({ v[0], v[1], v[3], v[4] }) + pattern1({ v[5], v[1], v[6], v[4] }));
+		return scale * (mc_pattern1<0, 1, 3, 4>(v) + mc_pattern1<5, 1, 6, 4>(v));
 	}
 	else if constexpr (N == 4) {
-		return scale * (pattern1({ v[0], v[1], v[3], v[4] }) + pattern1({ v[6], v[7], v[5], v[2] }));
+		return scale * (mc_pattern1<0, 1, 3, 4>(v) + mc_pattern1<6, 7, 5, 2>(v));
 	}
 	else if constexpr (N == 5) {
-		const fType e3 = get_len_frac(v[0], v[3]);
-		const fType vol0 = get_len_frac(v[1], v[5]) *
-			(1.0 - 0.5 * (1.0 - get_len_frac(v[0], v[1])) * (1.0 - e3)) / 3.0;
-		const fType e11 = get_len_frac(v[3], v[7]);
-		return vol0 + scale * ((get_len_frac(v[2], v[6]) + e11) + e3 * e11);
+		const T e3 = get_len_frac<0, 3>(v);
+		const T vol0 = get_len_frac<1, 5>(v) *
+			(T(1.0) - T(0.5) * (T(1.0) - get_len_frac<0, 1>(v)) * (T(1.0) - e3)) / T(3.0);
+		const T e11 = get_len_frac<3, 7>(v);
+		return vol0 + scale * ((get_len_frac<2, 6>(v) + e11) + e3 * e11);
 	}
 	else if constexpr (N == 6) {
-		return scale * (pattern2({ v[3], v[0], v[4], v[2], v[1], v[5] }) + pattern1({ v[6], v[7], v[5], v[2] }));
+		return scale * (mc_pattern2<3, 0, 4, 2, 1, 5>(v) + mc_pattern1<6, 7, 5, 2>(v));
 	}
 	else if constexpr (N == 7) {
-		return scale * (pattern1({ v[4], v[0], v[5], v[7] }) + pattern1({ v[1], v[0], v[2], v[5] }) +
-			pattern1({ v[6], v[7], v[5], v[2] }));
+		return scale * (mc_pattern1<4, 0, 5, 7>(v) + mc_pattern1<1, 0, 2, 5>(v) +
+			mc_pattern1<6, 7, 5, 2>(v));
 	}
 	else if constexpr (N == 8) {
-		return scale * (2.0 * get_len_frac(v[0], v[4]) + get_len_frac(v[1], v[5]) +
-			2.0 * get_len_frac(v[2], v[6]) + get_len_frac(v[3], v[7]));
+		return scale * (T(2.0) * get_len_frac<0, 4>(v) + get_len_frac<1, 5>(v) +
+			T(2.0) * get_len_frac<2, 6>(v) + get_len_frac<3, 7>(v));
 	}
 	else if constexpr (N == 9) {
-		const Vec3s e0 = get_e<0, true>(v), e1 = get_e<1, false>(v), e6 = get_e<6, true>(v),
-			e7 = get_e<7, false>(v), e8 = get_e<8, true>(v), e10 = get_e<10, true>(v);
-		const fType _e10 = get_len_frac(v[2], v[6]);
-		const fType _e6 = get_len_frac(v[6], v[7]);
-		const fType area =
-			(1.0 - 0.5 * (1.0 - _e6) * (1.0 - _e10)) / 3.0 +
-			scale * get_len_frac(v[1], v[2]) * _e10 +
-			scale * (_e6 * get_len_frac(v[4], v[7]));
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const T _e10 = get_len_frac<2, 6>(v);
+		const T _e6 = get_len_frac<6, 7>(v);
+		const T area =
+			(T(1.0) - T(0.5) * (T(1.0) - _e6) * (T(1.0) - _e10)) / T(3.0) +
+			scale * get_len_frac<1, 2>(v) * _e10 +
+			scale * (_e6 * get_len_frac<4, 7>(v));
 		if constexpr (M == 0) {
 			return area + scale * (sv(e10, e7, e6) + sv(e1, e7, e10) + sv(e1, e8, e7) + sv(e1, e0, e8));
 		}
@@ -292,145 +730,199 @@ constexpr fType get_mc_vol_case(const S8& v)
 		}
 	}
 	else if constexpr (N == 10) {
-		return scale * (pattern2({ v[4], v[7], v[6], v[0], v[3], v[2] }) + pattern2({ v[2], v[1], v[0], v[6], v[5], v[4] }));
+		return scale * (mc_pattern2<4, 7, 6, 0, 3, 2>(v) + mc_pattern2<2, 1, 0, 6, 5, 4>(v));
 	}
 	else if constexpr (N == 11) {
-		const Vec3s e0 = get_e<0, true>(v), e1 = get_e<1, false>(v), e5 = get_e<5, false>(v),
-			e6 = get_e<6, false>(v), e8 = get_e<8, true>(v), e11 = get_e<11, true>(v);
-		const fType _e5 = get_len_frac(v[5], v[6]);
-		const fType _e6 = get_len_frac(v[6], v[7]);
-		const fType area =
-			scale * (get_len_frac(v[1], v[2]) + _e5) +
-			(1.0 - 0.5 * (1.0 - _e6) * (1.0 - get_len_frac(v[3], v[7]))) / 3.0 +
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e6 = get_e<6, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e11 = get_e<11, true, B>(v);
+		const T _e5 = get_len_frac<5, 6>(v);
+		const T _e6 = get_len_frac<6, 7>(v);
+		const T area =
+			scale * (get_len_frac<1, 2>(v) + _e5) +
+			(T(1.0) - T(0.5) * (T(1.0) - _e6) * (T(1.0) - get_len_frac<3, 7>(v))) / T(3.0) +
 			scale * (_e5 * _e6);
 		return area + scale * (sv(e0, e8, e11) + sv(e0, e11, e5) + sv(e0, e5, e1) + sv(e5, e11, e6));
 	}
 	else if constexpr (N == 12) {
-		const fType e0 = get_len_frac(v[0], v[1]);
-		const fType e9 = get_len_frac(v[1], v[5]);
-		return get_len_frac(v[3], v[7]) * (1.0 - 0.5 * (1.0 - e0) * (1.0 - get_len_frac(v[0], v[3]))) / 3.0 +
-			scale * ((e9 + get_len_frac(v[2], v[6])) + e0 * e9 + pattern1({ v[4], v[0], v[5], v[7] }));
+		const T e0 = get_len_frac<0, 1>(v);
+		const T e9 = get_len_frac<1, 5>(v);
+		return get_len_frac<3, 7>(v) * (T(1.0) - T(0.5) * (T(1.0) - e0) * (T(1.0) - get_len_frac<0, 3>(v))) / T(3.0) +
+			scale * ((e9 + get_len_frac<2, 6>(v)) + e0 * e9 + mc_pattern1<4, 0, 5, 7>(v));
 	}
 	else if constexpr (N == 13) {
-		return scale * (pattern1({ v[4], v[0], v[5], v[7] }) + pattern1({ v[1], v[0], v[2], v[5] }) +
-			pattern1({ v[6], v[7], v[5], v[2] }) + pattern1({ v[3], v[0], v[2], v[7] }));
+		return scale * (mc_pattern1<4, 0, 5, 7>(v) + mc_pattern1<1, 0, 2, 5>(v) +
+			mc_pattern1<6, 7, 5, 2>(v) + mc_pattern1<3, 0, 2, 7>(v));
 	}
 	else if constexpr (N == 14) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e6 = get_e<6, true>(v),
-			e7 = get_e<7, false>(v), e9 = get_e<9, true>(v), e10 = get_e<10, true>(v);
-		const fType _e10 = get_len_frac(v[2], v[6]);
-		const fType _e6 = get_len_frac(v[6], v[7]);
-		const fType area = scale * (get_len_frac(v[1], v[5]) + _e10) +
-			scale * (_e6 * get_len_frac(v[4], v[7])) +
-			(1.0 - 0.5 * (1.0 - _e6) * (1.0 - _e10)) / 3.0;
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const T _e10 = get_len_frac<2, 6>(v);
+		const T _e6 = get_len_frac<6, 7>(v);
+		const T area = scale * (get_len_frac<1, 5>(v) + _e10) +
+			scale * (_e6 * get_len_frac<4, 7>(v)) +
+			(T(1.0) - T(0.5) * (T(1.0) - _e6) * (T(1.0) - _e10)) / T(3.0);
 		return area + scale * (sv(e0, e3, e7) + sv(e0, e7, e10) + sv(e0, e10, e9) + sv(e6, e10, e7));
 	}
 	else if constexpr (N == 15) {
-		const Vec3s e0 = get_e<0, true>(v), e1 = get_e<1, false>(v),
-			e6 = get_e<6, true>(v), e7 = get_e<7, false>(v),
-			e8 = get_e<8, true>(v), e10 = get_e<10, true>(v);
-		const fType _e10 = get_len_frac(v[2], v[6]);
-		const fType _e6 = get_len_frac(v[6], v[7]);
-		return (1.0 - 0.5 * (1.0 - _e6) * (1.0 - _e10)) / 3.0 +
-			scale * get_len_frac(v[1], v[2]) * _e10 +
-			scale * (_e6 * get_len_frac(v[4], v[7])) +
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const T _e10 = get_len_frac<2, 6>(v);
+		const T _e6 = get_len_frac<6, 7>(v);
+		return (T(1.0) - T(0.5) * (T(1.0) - _e6) * (T(1.0) - _e10)) / T(3.0) +
+			scale * get_len_frac<1, 2>(v) * _e10 +
+			scale * (_e6 * get_len_frac<4, 7>(v)) +
 			scale * (sv(e1, e6, e10) + sv(e1, e7, e6) + sv(e1, e0, e7) + sv(e8, e7, e0)) +
-			scale * pattern1({ v[5], v[4], v[1], v[6] });
+			scale * mc_pattern1<5, 4, 1, 6>(v);
 	}
 	else if constexpr (N == 16) {
-		const Vec3s e1 = get_e<1, false>(v), e3 = get_e<3, false>(v), e5 = get_e<5, true>(v),
-			e6 = get_e<6, true>(v), e8 = get_e<8, false>(v), e9 = get_e<9, false>(v),
-			e10 = get_e<10, true>(v);
-		const fType _e10 = get_len_frac(v[2], v[6]);
-		const fType _e5 = get_len_frac(v[5], v[6]);
-		const fType _e6 = get_len_frac(v[6], v[7]);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e5 = get_e<5, true, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, false, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const T _e10 = get_len_frac<2, 6>(v);
+		const T _e5 = get_len_frac<5, 6>(v);
+		const T _e6 = get_len_frac<6, 7>(v);
 		return scale * (sv(e1, e3, e6) + sv(e1, e6, e10) + sv(e3, e8, e6) + sv(e5, e6, e9) + sv(e8, e9, e6)) +
-			scale * (get_len_frac(v[1], v[2]) * _e10 + _e5 * get_len_frac(v[1], v[5])) +
-			(1.0 - 0.5 * (1.0 - _e6) * (1.0 - _e10)) / 3.0 +
-			(1.0 - 0.5 * (1.0 - _e6) * (1.0 - _e5)) / 3.0;
+			scale * (get_len_frac<1, 2>(v) * _e10 + _e5 * get_len_frac<1, 5>(v)) +
+			(T(1.0) - T(0.5) * (T(1.0) - _e6) * (T(1.0) - _e10)) / T(3.0) +
+			(T(1.0) - T(0.5) * (T(1.0) - _e6) * (T(1.0) - _e5)) / T(3.0);
 	}
 	else if constexpr (N == 17) {
-		const fType e3 = get_len_frac(v[0], v[3]);
-		const fType e11 = get_len_frac(v[3], v[7]);
-		return 1.0 - ((1.0 - get_len_frac(v[1], v[5])) * (1.0 - 0.5 * get_len_frac(v[0], v[1]) * e3) / 3.0 +
-			scale * ((1.0 - get_len_frac(v[2], v[6])) + (1.0 - e11) + (1.0 - e3) * (1.0 - e11)));
+		const T e3 = get_len_frac<0, 3>(v);
+		const T e11 = get_len_frac<3, 7>(v);
+		return T(1.0) - ((T(1.0) - get_len_frac<1, 5>(v)) * (T(1.0) - T(0.5) * get_len_frac<0, 1>(v) * e3) / T(3.0) +
+			scale * ((T(1.0) - get_len_frac<2, 6>(v)) + (T(1.0) - e11) + (T(1.0) - e3) * (T(1.0) - e11)));
 	}
 	else if constexpr (N == 18) {
-		return 1.0 - scale * (pattern21({ v[0], v[1], v[3], v[4] }) + pattern21({ v[6], v[5], v[2], v[7] }));
+		return T(1.0) - scale * (mc_pattern21<0, 1, 3, 4>(v) + mc_pattern21<6, 5, 2, 7>(v));
 	}
 	else if constexpr (N == 19) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e4 = get_e<4, true>(v),
-			e5 = get_e<5, false>(v), e8 = get_e<8, false>(v), e9 = get_e<9, true>(v);
-		const fType _e5 = get_len_frac(v[5], v[6]);
-		return 1.0 - (scale * (-sv(e8, e4, e5) - sv(e8, e5, e3) - sv(e9, e0, e5) - sv(e0, e3, e5)) +
-			(0.5 * (1.0 - get_len_frac(v[1], v[5])) * (1.0 - _e5)) / 3.0 +
-			(0.5 * (1.0 - _e5) * (1.0 - get_len_frac(v[4], v[5]))) / 3.0);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e4 = get_e<4, true, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const T _e5 = get_len_frac<5, 6>(v);
+		return T(1.0) - (scale * (-sv(e8, e4, e5) - sv(e8, e5, e3) - sv(e9, e0, e5) - sv(e0, e3, e5)) +
+			(T(0.5) * (T(1.0) - get_len_frac<1, 5>(v)) * (T(1.0) - _e5)) / T(3.0) +
+			(T(0.5) * (T(1.0) - _e5) * (T(1.0) - get_len_frac<4, 5>(v))) / T(3.0));
 	}
 	else if constexpr (N == 20) {
-		const fType e1 = get_len_frac(v[1], v[2]);
-		return 1.0 - scale * (((1.0 - get_len_frac(v[0], v[3])) +
-			(1.0 - e1)) * (1.0 - get_len_frac(v[0], v[4])) +
-			(1.0 - e1) * (1.0 - get_len_frac(v[1], v[5])));
+		const T e1 = get_len_frac<1, 2>(v);
+		return T(1.0) - scale * (((T(1.0) - get_len_frac<0, 3>(v)) +
+			(T(1.0) - e1)) * (T(1.0) - get_len_frac<0, 4>(v)) +
+			(T(1.0) - e1) * (T(1.0) - get_len_frac<1, 5>(v)));
 	}
 	else if constexpr (N == 21) {
-		return 1.0 - scale * pattern21({ v[0], v[1], v[3], v[4] });
+		return T(1.0) - scale * mc_pattern21<0, 1, 3, 4>(v);
 	}
 	else if constexpr (N == 22) {
-		return 1.0;
+		return T(1.0);
 	}
-	return 0.0;//dummy
+	return T(0.0);//dummy
 }
 
-template<iType N, iType M = 0>
-constexpr fType get_mc_area_case(const S8& v)
+template<iType N, iType M = 0, typename B = MCBackend, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_area_case(const V& v, const W& w = W())
 {
-	constexpr fType scale = 0.5;
-	const auto a = [](const Vec3s& v0, const Vec3s& v1, const Vec3s& v2) { return ((v1 - v0).cross(v2 - v0)).norm(); };
+	using T = typename V::value_type;
+	constexpr T scale = T(0.5);
+	const auto a = [&w](const auto& v0, const auto& v1, const auto& v2) { return get_mc_norm<T>(get_mc_weighted(w, get_mc_cross(v1 - v0, v2 - v0))); };
 
 	if constexpr (N == 0) {
-		return 0.0;
+		return T(0.0);
 	}
 	else if constexpr (N == 1) {
-		const Vec3s e0 = get_e<0, true>(v), e3 = get_e<3, true>(v), e8 = get_e<8, true>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e3 = get_e<3, true, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
 		return scale * (a(e0, e8, e3));
 	}
 	else if constexpr (N == 2) {
-		const Vec3s e1 = get_e<1, true>(v), e3 = get_e<3, true>(v), e8 = get_e<8, true>(v), e9 = get_e<9, true>(v);
+		const auto e1 = get_e<1, true, B>(v);
+		const auto e3 = get_e<3, true, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
 		return scale * (a(e1, e8, e3) + a(e9, e8, e1));
 	}
 	else if constexpr (N == 3) {
-		const Vec3s e0 = get_e<0, true>(v), e3 = get_e<3, true>(v), e4 = get_e<4, false>(v),
-			e5 = get_e<5, true>(v), e8 = get_e<8, true>(v), e9 = get_e<9, false>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e3 = get_e<3, true, B>(v);
+		const auto e4 = get_e<4, false, B>(v);
+		const auto e5 = get_e<5, true, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e9 = get_e<9, false, B>(v);
 		return scale * (a(e9, e5, e4) + a(e0, e8, e3));
 	}
 	else if constexpr (N == 4) {
-		const Vec3s e0 = get_e<0, true>(v), e3 = get_e<3, true>(v), e5 = get_e<5, false>(v),
-			e6 = get_e<6, false>(v), e8 = get_e<8, true>(v), e10 = get_e<10, false>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e3 = get_e<3, true, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e6 = get_e<6, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e10 = get_e<10, false, B>(v);
 		return scale * (a(e0, e8, e3) + a(e5, e10, e6));
 	}
 	else if constexpr (N == 5) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e9 = get_e<9, true>(v),
-			e10 = get_e<10, true>(v), e11 = get_e<11, true>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const auto e11 = get_e<11, true, B>(v);
 		return scale * (a(e3, e9, e0) + a(e3, e11, e9) + a(e11, e10, e9));
 	}
 	else if constexpr (N == 6) {
-		const Vec3s e1 = get_e<1, true>(v), e3 = get_e<3, true>(v), e5 = get_e<5, false>(v),
-			e6 = get_e<6, false>(v), e8 = get_e<8, true>(v), e9 = get_e<9, true>(v), e10 = get_e<10, false>(v);
+		const auto e1 = get_e<1, true, B>(v);
+		const auto e3 = get_e<3, true, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e6 = get_e<6, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, false, B>(v);
 		return scale * (a(e1, e8, e3) + a(e1, e9, e8) + a(e5, e10, e6));
 	}
 	else if constexpr (N == 7) {
-		const Vec3s e0 = get_e<0, false>(v), e1 = get_e<1, true>(v), e4 = get_e<4, true>(v),
-			e5 = get_e<5, false>(v), e6 = get_e<6, false>(v), e7 = get_e<7, true>(v),
-			e8 = get_e<8, false>(v), e9 = get_e<9, true>(v), e10 = get_e<10, false>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e1 = get_e<1, true, B>(v);
+		const auto e4 = get_e<4, true, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e6 = get_e<6, false, B>(v);
+		const auto e7 = get_e<7, true, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, false, B>(v);
 		return scale * (a(e1, e9, e0) + a(e5, e10, e6) + a(e8, e4, e7));
 	}
 	else if constexpr (N == 8) {
-		const Vec3s e8 = get_e<8, true>(v), e9 = get_e<9, true>(v), e10 = get_e<10, true>(v), e11 = get_e<11, true>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const auto e11 = get_e<11, true, B>(v);
 		return scale * (a(e9, e8, e10) + a(e10, e8, e11));
 	}
 	else if constexpr (N == 9) {
-		const Vec3s e0 = get_e<0, true>(v), e1 = get_e<1, false>(v), e6 = get_e<6, true>(v),
-			e7 = get_e<7, false>(v), e8 = get_e<8, true>(v), e10 = get_e<10, true>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
 		if constexpr (M == 0) {
 			return scale * (a(e10, e7, e6) + a(e1, e7, e10) + a(e1, e8, e7) + a(e1, e0, e8));
 		}
@@ -439,598 +931,1413 @@ constexpr fType get_mc_area_case(const S8& v)
 		}
 	}
 	else if constexpr (N == 10) {
-		const Vec3s e0 = get_e<0, false>(v), e1 = get_e<1, true>(v), e2 = get_e<2, true>(v),
-			e3 = get_e<3, false>(v), e4 = get_e<4, false>(v), e5 = get_e<5, true>(v),
-			e6 = get_e<6, true>(v), e7 = get_e<7, false>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e1 = get_e<1, true, B>(v);
+		const auto e2 = get_e<2, true, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e4 = get_e<4, false, B>(v);
+		const auto e5 = get_e<5, true, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
 		return scale * (a(e3, e6, e2) + a(e3, e7, e6) + a(e1, e5, e0) + a(e5, e4, e0));
 	}
 	else if constexpr (N == 11) {
-		const Vec3s e0 = get_e<0, true>(v), e1 = get_e<1, false>(v), e5 = get_e<5, false>(v),
-			e6 = get_e<6, false>(v), e8 = get_e<8, true>(v), e11 = get_e<11, true>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e6 = get_e<6, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e11 = get_e<11, true, B>(v);
 		return scale * (a(e0, e8, e11) + a(e0, e11, e5) + a(e0, e5, e1) + a(e5, e11, e6));
 	}
 	else if constexpr (N == 12) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e4 = get_e<4, true>(v),
-			e7 = get_e<7, true>(v), e8 = get_e<8, false>(v), e9 = get_e<9, true>(v),
-			e10 = get_e<10, true>(v), e11 = get_e<11, true>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e4 = get_e<4, true, B>(v);
+		const auto e7 = get_e<7, true, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
+		const auto e11 = get_e<11, true, B>(v);
 		return scale * (a(e4, e7, e8) + a(e9, e0, e11) + a(e9, e11, e10) + a(e11, e0, e3));
 	}
 	else if constexpr (N == 13) {
-		const Vec3s e0 = get_e<0, false>(v), e1 = get_e<1, true>(v), e2 = get_e<2, true>(v),
-			e3 = get_e<3, false>(v), e4 = get_e<4, true>(v), e5 = get_e<5, false>(v),
-			e6 = get_e<6, false>(v), e7 = get_e<7, true>(v), e8 = get_e<8, false>(v),
-			e9 = get_e<9, true>(v), e10 = get_e<10, false>(v), e11 = get_e<11, true>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e1 = get_e<1, true, B>(v);
+		const auto e2 = get_e<2, true, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e4 = get_e<4, true, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e6 = get_e<6, false, B>(v);
+		const auto e7 = get_e<7, true, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, false, B>(v);
+		const auto e11 = get_e<11, true, B>(v);
 		return scale * (a(e0, e1, e9) + a(e4, e7, e8) + a(e2, e3, e11) + a(e5, e10, e6));
 	}
 	else if constexpr (N == 14) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e6 = get_e<6, true>(v),
-			e7 = get_e<7, false>(v), e9 = get_e<9, true>(v), e10 = get_e<10, true>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
 		return scale * (a(e0, e3, e7) + a(e0, e7, e10) + a(e0, e10, e9) + a(e6, e10, e7));
 	}
 	else if constexpr (N == 15) {
-		const Vec3s e0 = get_e<0, true>(v), e1 = get_e<1, false>(v), e4 = get_e<4, false>(v),
-			e5 = get_e<5, true>(v), e6 = get_e<6, true>(v), e7 = get_e<7, false>(v),
-			e8 = get_e<8, true>(v), e9 = get_e<9, false>(v), e10 = get_e<10, true>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e4 = get_e<4, false, B>(v);
+		const auto e5 = get_e<5, true, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e7 = get_e<7, false, B>(v);
+		const auto e8 = get_e<8, true, B>(v);
+		const auto e9 = get_e<9, false, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
 		return scale * (a(e1, e6, e10) + a(e1, e7, e6) + a(e1, e0, e7) + a(e8, e7, e0) + a(e9, e5, e4));
 	}
 	else if constexpr (N == 16) {
-		const Vec3s e1 = get_e<1, false>(v), e3 = get_e<3, false>(v), e5 = get_e<5, true>(v),
-			e6 = get_e<6, true>(v), e8 = get_e<8, false>(v), e9 = get_e<9, false>(v), e10 = get_e<10, true>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e5 = get_e<5, true, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, false, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
 		return scale * (a(e1, e3, e6) + a(e1, e6, e10) + a(e3, e8, e6) + a(e5, e6, e9) + a(e8, e9, e6));
 	}
 	else if constexpr (N == 17) {
-		const Vec3s e0 = get_e<0, true>(v), e3 = get_e<3, true>(v), e9 = get_e<9, false>(v),
-			e10 = get_e<10, false>(v), e11 = get_e<11, false>(v);
+		const auto e0 = get_e<0, true, B>(v);
+		const auto e3 = get_e<3, true, B>(v);
+		const auto e9 = get_e<9, false, B>(v);
+		const auto e10 = get_e<10, false, B>(v);
+		const auto e11 = get_e<11, false, B>(v);
 		return scale * (a(e3, e0, e9) + a(e3, e9, e11) + a(e11, e9, e10));
 	}
 	else if constexpr (N == 18) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e5 = get_e<5, true>(v),
-			e6 = get_e<6, true>(v), e8 = get_e<8, false>(v), e10 = get_e<10, true>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e5 = get_e<5, true, B>(v);
+		const auto e6 = get_e<6, true, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e10 = get_e<10, true, B>(v);
 		return scale * (a(e0, e3, e8) + a(e5, e6, e10));
 	}
 	else if constexpr (N == 19) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e4 = get_e<4, true>(v),
-			e5 = get_e<5, false>(v), e8 = get_e<8, false>(v), e9 = get_e<9, true>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e4 = get_e<4, true, B>(v);
+		const auto e5 = get_e<5, false, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, true, B>(v);
 		return scale * (a(e8, e4, e5) + a(e8, e5, e3) + a(e9, e0, e5) + a(e0, e3, e5));
 	}
 	else if constexpr (N == 20) {
-		const Vec3s e1 = get_e<1, false>(v), e3 = get_e<3, false>(v), e8 = get_e<8, false>(v), e9 = get_e<9, false>(v);
+		const auto e1 = get_e<1, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
+		const auto e9 = get_e<9, false, B>(v);
 		return scale * (a(e1, e3, e8) + a(e9, e1, e8));
 	}
 	else if constexpr (N == 21) {
-		const Vec3s e0 = get_e<0, false>(v), e3 = get_e<3, false>(v), e8 = get_e<8, false>(v);
+		const auto e0 = get_e<0, false, B>(v);
+		const auto e3 = get_e<3, false, B>(v);
+		const auto e8 = get_e<8, false, B>(v);
 		return scale * (a(e0, e3, e8));
 	}
 	else if constexpr (N == 22) {
-		return 0.0;
-	}
-	return 0.0;//dummy
-}
-
-constexpr fType get_mc_vol(const S8& v)
-{
-	switch (const iType table_index = get_mc_table_index(v); table_index) {
-	case 0: return get_mc_vol_case<0, 0>(get_rotated_vals<fType, 0>(v));
-	case 1: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 0>(v));
-	case 2: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 6>(v));
-	case 3: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 0>(v));
-	case 4: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 8>(v));
-	case 5: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 12>(v));
-	case 6: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 12>(v));
-	case 7: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 7>(v));
-	case 8: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 3>(v));
-	case 9: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 7>(v));
-	case 10: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 3>(v));
-	case 11: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 8>(v));
-	case 12: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 8>(v));
-	case 13: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 9>(v));
-	case 14: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 0>(v));
-	case 15: return get_mc_vol_case<8, 0>(get_rotated_vals<fType, 0>(v));
-	case 16: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 1>(v));
-	case 17: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 10>(v));
-	case 18: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 4>(v));
-	case 19: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 13>(v));
-	case 20: return get_mc_vol_case<4, 0>(get_rotated_vals<fType, 8>(v));
-	case 21: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 4>(v));
-	case 22: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 12>(v));
-	case 23: return get_mc_vol_case<11, 0>(get_rotated_vals<fType, 8>(v));
-	case 24: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 7>(v));
-	case 25: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 17>(v));
-	case 26: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 12>(v));
-	case 27: return get_mc_vol_case<9, 1>(get_rotated_vals<fType, 19>(v));
-	case 28: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 8>(v));
-	case 29: return get_mc_vol_case<14, 1>(get_rotated_vals<fType, 9>(v));
-	case 30: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 0>(v));
-	case 31: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 22>(v));
-	case 32: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 5>(v));
-	case 33: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 0>(v));
-	case 34: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 13>(v));
-	case 35: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 1>(v));
-	case 36: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 13>(v));
-	case 37: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 4>(v));
-	case 38: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 21>(v));
-	case 39: return get_mc_vol_case<9, 1>(get_rotated_vals<fType, 14>(v));
-	case 40: return get_mc_vol_case<4, 0>(get_rotated_vals<fType, 5>(v));
-	case 41: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 7>(v));
-	case 42: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 13>(v));
-	case 43: return get_mc_vol_case<14, 0>(get_rotated_vals<fType, 8>(v));
-	case 44: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 3>(v));
-	case 45: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 9>(v));
-	case 46: return get_mc_vol_case<11, 0>(get_rotated_vals<fType, 14>(v));
-	case 47: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 5>(v));
-	case 48: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 1>(v));
-	case 49: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 18>(v));
-	case 50: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 10>(v));
-	case 51: return get_mc_vol_case<8, 0>(get_rotated_vals<fType, 13>(v));
-	case 52: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 1>(v));
-	case 53: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 18>(v));
-	case 54: return get_mc_vol_case<14, 0>(get_rotated_vals<fType, 10>(v));
-	case 55: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 16>(v));
-	case 56: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 5>(v));
-	case 57: return get_mc_vol_case<11, 0>(get_rotated_vals<fType, 13>(v));
-	case 58: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 10>(v));
-	case 59: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 3>(v));
-	case 60: return get_mc_vol_case<10, 0>(get_rotated_vals<fType, 21>(v));
-	case 61: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 2>(v));
-	case 62: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 20>(v));
-	case 63: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 20>(v));
-	case 64: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 20>(v));
-	case 65: return get_mc_vol_case<4, 0>(get_rotated_vals<fType, 0>(v));
-	case 66: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 23>(v));
-	case 67: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 0>(v));
-	case 68: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 21>(v));
-	case 69: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 21>(v));
-	case 70: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 14>(v));
-	case 71: return get_mc_vol_case<14, 0>(get_rotated_vals<fType, 14>(v));
-	case 72: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 21>(v));
-	case 73: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 11>(v));
-	case 74: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 13>(v));
-	case 75: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 8>(v));
-	case 76: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 15>(v));
-	case 77: return get_mc_vol_case<11, 0>(get_rotated_vals<fType, 0>(v));
-	case 78: return get_mc_vol_case<9, 1>(get_rotated_vals<fType, 20>(v));
-	case 79: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 23>(v));
-	case 80: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 1>(v));
-	case 81: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 10>(v));
-	case 82: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 0>(v));
-	case 83: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 13>(v));
-	case 84: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 16>(v));
-	case 85: return get_mc_vol_case<10, 0>(get_rotated_vals<fType, 7>(v));
-	case 86: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 14>(v));
-	case 87: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 19>(v));
-	case 88: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 8>(v));
-	case 89: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 17>(v));
-	case 90: return get_mc_vol_case<13, 0>(get_rotated_vals<fType, 0>(v));
-	case 91: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 1>(v));
-	case 92: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 15>(v));
-	case 93: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 6>(v));
-	case 94: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 7>(v));
-	case 95: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 17>(v));
-	case 96: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 14>(v));
-	case 97: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 23>(v));
-	case 98: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 12>(v));
-	case 99: return get_mc_vol_case<11, 0>(get_rotated_vals<fType, 10>(v));
-	case 100: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 6>(v));
-	case 101: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 6>(v));
-	case 102: return get_mc_vol_case<8, 0>(get_rotated_vals<fType, 12>(v));
-	case 103: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 11>(v));
-	case 104: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 14>(v));
-	case 105: return get_mc_vol_case<10, 0>(get_rotated_vals<fType, 1>(v));
-	case 106: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 12>(v));
-	case 107: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 22>(v));
-	case 108: return get_mc_vol_case<14, 1>(get_rotated_vals<fType, 6>(v));
-	case 109: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 17>(v));
-	case 110: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 19>(v));
-	case 111: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 22>(v));
-	case 112: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 2>(v));
-	case 113: return get_mc_vol_case<14, 1>(get_rotated_vals<fType, 18>(v));
-	case 114: return get_mc_vol_case<9, 1>(get_rotated_vals<fType, 22>(v));
-	case 115: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 20>(v));
-	case 116: return get_mc_vol_case<11, 0>(get_rotated_vals<fType, 12>(v));
-	case 117: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 15>(v));
-	case 118: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 4>(v));
-	case 119: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 19>(v));
-	case 120: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 2>(v));
-	case 121: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 9>(v));
-	case 122: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 21>(v));
-	case 123: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 2>(v));
-	case 124: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 18>(v));
-	case 125: return get_mc_vol_case<18, 0>(get_rotated_vals<fType, 6>(v));
-	case 126: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 15>(v));
-	case 127: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 2>(v));
-	case 128: return get_mc_vol_case<1, 0>(get_rotated_vals<fType, 2>(v));
-	case 129: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 15>(v));
-	case 130: return get_mc_vol_case<4, 0>(get_rotated_vals<fType, 6>(v));
-	case 131: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 18>(v));
-	case 132: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 2>(v));
-	case 133: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 21>(v));
-	case 134: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 9>(v));
-	case 135: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 7>(v));
-	case 136: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 19>(v));
-	case 137: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 4>(v));
-	case 138: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 15>(v));
-	case 139: return get_mc_vol_case<11, 1>(get_rotated_vals<fType, 9>(v));
-	case 140: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 20>(v));
-	case 141: return get_mc_vol_case<9, 0>(get_rotated_vals<fType, 0>(v));
-	case 142: return get_mc_vol_case<14, 0>(get_rotated_vals<fType, 0>(v));
-	case 143: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 2>(v));
-	case 144: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 22>(v));
-	case 145: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 19>(v));
-	case 146: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 17>(v));
-	case 147: return get_mc_vol_case<14, 0>(get_rotated_vals<fType, 13>(v));
-	case 148: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 22>(v));
-	case 149: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 19>(v));
-	case 150: return get_mc_vol_case<10, 0>(get_rotated_vals<fType, 13>(v));
-	case 151: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 14>(v));
-	case 152: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 11>(v));
-	case 153: return get_mc_vol_case<8, 0>(get_rotated_vals<fType, 4>(v));
-	case 154: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 11>(v));
-	case 155: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 6>(v));
-	case 156: return get_mc_vol_case<11, 1>(get_rotated_vals<fType, 4>(v));
-	case 157: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 12>(v));
-	case 158: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 23>(v));
-	case 159: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 14>(v));
-	case 160: return get_mc_vol_case<3, 0>(get_rotated_vals<fType, 17>(v));
-	case 161: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 7>(v));
-	case 162: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 6>(v));
-	case 163: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 1>(v));
-	case 164: return get_mc_vol_case<7, 0>(get_rotated_vals<fType, 1>(v));
-	case 165: return get_mc_vol_case<13, 0>(get_rotated_vals<fType, 19>(v));
-	case 166: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 21>(v));
-	case 167: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 8>(v));
-	case 168: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 19>(v));
-	case 169: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 4>(v));
-	case 170: return get_mc_vol_case<10, 0>(get_rotated_vals<fType, 0>(v));
-	case 171: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 16>(v));
-	case 172: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 20>(v));
-	case 173: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 0>(v));
-	case 174: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 10>(v));
-	case 175: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 1>(v));
-	case 176: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 23>(v));
-	case 177: return get_mc_vol_case<9, 0>(get_rotated_vals<fType, 13>(v));
-	case 178: return get_mc_vol_case<11, 1>(get_rotated_vals<fType, 18>(v));
-	case 179: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 15>(v));
-	case 180: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 23>(v));
-	case 181: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 13>(v));
-	case 182: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 11>(v));
-	case 183: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 21>(v));
-	case 184: return get_mc_vol_case<14, 1>(get_rotated_vals<fType, 23>(v));
-	case 185: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 14>(v));
-	case 186: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 21>(v));
-	case 187: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 21>(v));
-	case 188: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 0>(v));
-	case 189: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 23>(v));
-	case 190: return get_mc_vol_case<18, 0>(get_rotated_vals<fType, 0>(v));
-	case 191: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 20>(v));
-	case 192: return get_mc_vol_case<2, 0>(get_rotated_vals<fType, 20>(v));
-	case 193: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 20>(v));
-	case 194: return get_mc_vol_case<6, 0>(get_rotated_vals<fType, 2>(v));
-	case 195: return get_mc_vol_case<10, 0>(get_rotated_vals<fType, 12>(v));
-	case 196: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 3>(v));
-	case 197: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 3>(v));
-	case 198: return get_mc_vol_case<11, 1>(get_rotated_vals<fType, 6>(v));
-	case 199: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 5>(v));
-	case 200: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 16>(v));
-	case 201: return get_mc_vol_case<14, 1>(get_rotated_vals<fType, 4>(v));
-	case 202: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 16>(v));
-	case 203: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 1>(v));
-	case 204: return get_mc_vol_case<8, 0>(get_rotated_vals<fType, 3>(v));
-	case 205: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 10>(v));
-	case 206: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 18>(v));
-	case 207: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 1>(v));
-	case 208: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 5>(v));
-	case 209: return get_mc_vol_case<11, 1>(get_rotated_vals<fType, 23>(v));
-	case 210: return get_mc_vol_case<12, 0>(get_rotated_vals<fType, 5>(v));
-	case 211: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 3>(v));
-	case 212: return get_mc_vol_case<14, 1>(get_rotated_vals<fType, 3>(v));
-	case 213: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 13>(v));
-	case 214: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 7>(v));
-	case 215: return get_mc_vol_case<18, 0>(get_rotated_vals<fType, 5>(v));
-	case 216: return get_mc_vol_case<9, 0>(get_rotated_vals<fType, 4>(v));
-	case 217: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 21>(v));
-	case 218: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 4>(v));
-	case 219: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 13>(v));
-	case 220: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 1>(v));
-	case 221: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 13>(v));
-	case 222: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 0>(v));
-	case 223: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 5>(v));
-	case 224: return get_mc_vol_case<5, 0>(get_rotated_vals<fType, 22>(v));
-	case 225: return get_mc_vol_case<12, 1>(get_rotated_vals<fType, 22>(v));
-	case 226: return get_mc_vol_case<14, 0>(get_rotated_vals<fType, 12>(v));
-	case 227: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 8>(v));
-	case 228: return get_mc_vol_case<9, 0>(get_rotated_vals<fType, 12>(v));
-	case 229: return get_mc_vol_case<15, 0>(get_rotated_vals<fType, 12>(v));
-	case 230: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 17>(v));
-	case 231: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 7>(v));
-	case 232: return get_mc_vol_case<11, 1>(get_rotated_vals<fType, 3>(v));
-	case 233: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 12>(v));
-	case 234: return get_mc_vol_case<16, 0>(get_rotated_vals<fType, 4>(v));
-	case 235: return get_mc_vol_case<18, 0>(get_rotated_vals<fType, 8>(v));
-	case 236: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 13>(v));
-	case 237: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 4>(v));
-	case 238: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 10>(v));
-	case 239: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 1>(v));
-	case 240: return get_mc_vol_case<8, 0>(get_rotated_vals<fType, 23>(v));
-	case 241: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 0>(v));
-	case 242: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 9>(v));
-	case 243: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 8>(v));
-	case 244: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 8>(v));
-	case 245: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 3>(v));
-	case 246: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 7>(v));
-	case 247: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 3>(v));
-	case 248: return get_mc_vol_case<17, 0>(get_rotated_vals<fType, 7>(v));
-	case 249: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 12>(v));
-	case 250: return get_mc_vol_case<19, 0>(get_rotated_vals<fType, 12>(v));
-	case 251: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 8>(v));
-	case 252: return get_mc_vol_case<20, 0>(get_rotated_vals<fType, 0>(v));
-	case 253: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 6>(v));
-	case 254: return get_mc_vol_case<21, 0>(get_rotated_vals<fType, 0>(v));
-	case 255: return get_mc_vol_case<22, 0>(get_rotated_vals<fType, 0>(v));
-	default: return 0.0;//dummy
-	}
-}
-
-constexpr fType get_mc_area(const S8& v)
-{
-	switch (const iType table_index = get_mc_table_index(v); table_index) {
-	case 0: return get_mc_area_case<0, 0>(get_rotated_vals<fType, 0>(v));
-	case 1: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 0>(v));
-	case 2: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 6>(v));
-	case 3: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 0>(v));
-	case 4: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 8>(v));
-	case 5: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 12>(v));
-	case 6: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 12>(v));
-	case 7: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 7>(v));
-	case 8: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 3>(v));
-	case 9: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 7>(v));
-	case 10: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 3>(v));
-	case 11: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 8>(v));
-	case 12: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 8>(v));
-	case 13: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 9>(v));
-	case 14: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 0>(v));
-	case 15: return get_mc_area_case<8, 0>(get_rotated_vals<fType, 0>(v));
-	case 16: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 1>(v));
-	case 17: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 10>(v));
-	case 18: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 4>(v));
-	case 19: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 13>(v));
-	case 20: return get_mc_area_case<4, 0>(get_rotated_vals<fType, 8>(v));
-	case 21: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 4>(v));
-	case 22: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 12>(v));
-	case 23: return get_mc_area_case<11, 0>(get_rotated_vals<fType, 8>(v));
-	case 24: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 7>(v));
-	case 25: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 17>(v));
-	case 26: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 12>(v));
-	case 27: return get_mc_area_case<9, 1>(get_rotated_vals<fType, 19>(v));
-	case 28: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 8>(v));
-	case 29: return get_mc_area_case<14, 1>(get_rotated_vals<fType, 9>(v));
-	case 30: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 0>(v));
-	case 31: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 22>(v));
-	case 32: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 5>(v));
-	case 33: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 0>(v));
-	case 34: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 13>(v));
-	case 35: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 1>(v));
-	case 36: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 13>(v));
-	case 37: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 4>(v));
-	case 38: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 21>(v));
-	case 39: return get_mc_area_case<9, 1>(get_rotated_vals<fType, 14>(v));
-	case 40: return get_mc_area_case<4, 0>(get_rotated_vals<fType, 5>(v));
-	case 41: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 7>(v));
-	case 42: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 13>(v));
-	case 43: return get_mc_area_case<14, 0>(get_rotated_vals<fType, 8>(v));
-	case 44: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 3>(v));
-	case 45: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 9>(v));
-	case 46: return get_mc_area_case<11, 0>(get_rotated_vals<fType, 14>(v));
-	case 47: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 5>(v));
-	case 48: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 1>(v));
-	case 49: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 18>(v));
-	case 50: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 10>(v));
-	case 51: return get_mc_area_case<8, 0>(get_rotated_vals<fType, 13>(v));
-	case 52: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 1>(v));
-	case 53: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 18>(v));
-	case 54: return get_mc_area_case<14, 0>(get_rotated_vals<fType, 10>(v));
-	case 55: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 16>(v));
-	case 56: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 5>(v));
-	case 57: return get_mc_area_case<11, 0>(get_rotated_vals<fType, 13>(v));
-	case 58: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 10>(v));
-	case 59: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 3>(v));
-	case 60: return get_mc_area_case<10, 0>(get_rotated_vals<fType, 21>(v));
-	case 61: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 2>(v));
-	case 62: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 20>(v));
-	case 63: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 20>(v));
-	case 64: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 20>(v));
-	case 65: return get_mc_area_case<4, 0>(get_rotated_vals<fType, 0>(v));
-	case 66: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 23>(v));
-	case 67: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 0>(v));
-	case 68: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 21>(v));
-	case 69: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 21>(v));
-	case 70: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 14>(v));
-	case 71: return get_mc_area_case<14, 0>(get_rotated_vals<fType, 14>(v));
-	case 72: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 21>(v));
-	case 73: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 11>(v));
-	case 74: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 13>(v));
-	case 75: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 8>(v));
-	case 76: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 15>(v));
-	case 77: return get_mc_area_case<11, 0>(get_rotated_vals<fType, 0>(v));
-	case 78: return get_mc_area_case<9, 1>(get_rotated_vals<fType, 20>(v));
-	case 79: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 23>(v));
-	case 80: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 1>(v));
-	case 81: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 10>(v));
-	case 82: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 0>(v));
-	case 83: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 13>(v));
-	case 84: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 16>(v));
-	case 85: return get_mc_area_case<10, 0>(get_rotated_vals<fType, 7>(v));
-	case 86: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 14>(v));
-	case 87: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 19>(v));
-	case 88: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 8>(v));
-	case 89: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 17>(v));
-	case 90: return get_mc_area_case<13, 0>(get_rotated_vals<fType, 0>(v));
-	case 91: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 1>(v));
-	case 92: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 15>(v));
-	case 93: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 6>(v));
-	case 94: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 7>(v));
-	case 95: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 17>(v));
-	case 96: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 14>(v));
-	case 97: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 23>(v));
-	case 98: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 12>(v));
-	case 99: return get_mc_area_case<11, 0>(get_rotated_vals<fType, 10>(v));
-	case 100: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 6>(v));
-	case 101: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 6>(v));
-	case 102: return get_mc_area_case<8, 0>(get_rotated_vals<fType, 12>(v));
-	case 103: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 11>(v));
-	case 104: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 14>(v));
-	case 105: return get_mc_area_case<10, 0>(get_rotated_vals<fType, 1>(v));
-	case 106: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 12>(v));
-	case 107: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 22>(v));
-	case 108: return get_mc_area_case<14, 1>(get_rotated_vals<fType, 6>(v));
-	case 109: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 17>(v));
-	case 110: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 19>(v));
-	case 111: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 22>(v));
-	case 112: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 2>(v));
-	case 113: return get_mc_area_case<14, 1>(get_rotated_vals<fType, 18>(v));
-	case 114: return get_mc_area_case<9, 1>(get_rotated_vals<fType, 22>(v));
-	case 115: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 20>(v));
-	case 116: return get_mc_area_case<11, 0>(get_rotated_vals<fType, 12>(v));
-	case 117: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 15>(v));
-	case 118: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 4>(v));
-	case 119: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 19>(v));
-	case 120: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 2>(v));
-	case 121: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 9>(v));
-	case 122: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 21>(v));
-	case 123: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 2>(v));
-	case 124: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 18>(v));
-	case 125: return get_mc_area_case<18, 0>(get_rotated_vals<fType, 6>(v));
-	case 126: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 15>(v));
-	case 127: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 2>(v));
-	case 128: return get_mc_area_case<1, 0>(get_rotated_vals<fType, 2>(v));
-	case 129: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 15>(v));
-	case 130: return get_mc_area_case<4, 0>(get_rotated_vals<fType, 6>(v));
-	case 131: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 18>(v));
-	case 132: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 2>(v));
-	case 133: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 21>(v));
-	case 134: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 9>(v));
-	case 135: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 7>(v));
-	case 136: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 19>(v));
-	case 137: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 4>(v));
-	case 138: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 15>(v));
-	case 139: return get_mc_area_case<11, 1>(get_rotated_vals<fType, 9>(v));
-	case 140: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 20>(v));
-	case 141: return get_mc_area_case<9, 0>(get_rotated_vals<fType, 0>(v));
-	case 142: return get_mc_area_case<14, 0>(get_rotated_vals<fType, 0>(v));
-	case 143: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 2>(v));
-	case 144: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 22>(v));
-	case 145: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 19>(v));
-	case 146: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 17>(v));
-	case 147: return get_mc_area_case<14, 0>(get_rotated_vals<fType, 13>(v));
-	case 148: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 22>(v));
-	case 149: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 19>(v));
-	case 150: return get_mc_area_case<10, 0>(get_rotated_vals<fType, 13>(v));
-	case 151: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 14>(v));
-	case 152: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 11>(v));
-	case 153: return get_mc_area_case<8, 0>(get_rotated_vals<fType, 4>(v));
-	case 154: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 11>(v));
-	case 155: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 6>(v));
-	case 156: return get_mc_area_case<11, 1>(get_rotated_vals<fType, 4>(v));
-	case 157: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 12>(v));
-	case 158: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 23>(v));
-	case 159: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 14>(v));
-	case 160: return get_mc_area_case<3, 0>(get_rotated_vals<fType, 17>(v));
-	case 161: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 7>(v));
-	case 162: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 6>(v));
-	case 163: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 1>(v));
-	case 164: return get_mc_area_case<7, 0>(get_rotated_vals<fType, 1>(v));
-	case 165: return get_mc_area_case<13, 0>(get_rotated_vals<fType, 19>(v));
-	case 166: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 21>(v));
-	case 167: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 8>(v));
-	case 168: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 19>(v));
-	case 169: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 4>(v));
-	case 170: return get_mc_area_case<10, 0>(get_rotated_vals<fType, 0>(v));
-	case 171: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 16>(v));
-	case 172: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 20>(v));
-	case 173: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 0>(v));
-	case 174: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 10>(v));
-	case 175: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 1>(v));
-	case 176: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 23>(v));
-	case 177: return get_mc_area_case<9, 0>(get_rotated_vals<fType, 13>(v));
-	case 178: return get_mc_area_case<11, 1>(get_rotated_vals<fType, 18>(v));
-	case 179: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 15>(v));
-	case 180: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 23>(v));
-	case 181: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 13>(v));
-	case 182: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 11>(v));
-	case 183: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 21>(v));
-	case 184: return get_mc_area_case<14, 1>(get_rotated_vals<fType, 23>(v));
-	case 185: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 14>(v));
-	case 186: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 21>(v));
-	case 187: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 21>(v));
-	case 188: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 0>(v));
-	case 189: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 23>(v));
-	case 190: return get_mc_area_case<18, 0>(get_rotated_vals<fType, 0>(v));
-	case 191: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 20>(v));
-	case 192: return get_mc_area_case<2, 0>(get_rotated_vals<fType, 20>(v));
-	case 193: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 20>(v));
-	case 194: return get_mc_area_case<6, 0>(get_rotated_vals<fType, 2>(v));
-	case 195: return get_mc_area_case<10, 0>(get_rotated_vals<fType, 12>(v));
-	case 196: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 3>(v));
-	case 197: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 3>(v));
-	case 198: return get_mc_area_case<11, 1>(get_rotated_vals<fType, 6>(v));
-	case 199: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 5>(v));
-	case 200: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 16>(v));
-	case 201: return get_mc_area_case<14, 1>(get_rotated_vals<fType, 4>(v));
-	case 202: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 16>(v));
-	case 203: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 1>(v));
-	case 204: return get_mc_area_case<8, 0>(get_rotated_vals<fType, 3>(v));
-	case 205: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 10>(v));
-	case 206: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 18>(v));
-	case 207: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 1>(v));
-	case 208: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 5>(v));
-	case 209: return get_mc_area_case<11, 1>(get_rotated_vals<fType, 23>(v));
-	case 210: return get_mc_area_case<12, 0>(get_rotated_vals<fType, 5>(v));
-	case 211: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 3>(v));
-	case 212: return get_mc_area_case<14, 1>(get_rotated_vals<fType, 3>(v));
-	case 213: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 13>(v));
-	case 214: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 7>(v));
-	case 215: return get_mc_area_case<18, 0>(get_rotated_vals<fType, 5>(v));
-	case 216: return get_mc_area_case<9, 0>(get_rotated_vals<fType, 4>(v));
-	case 217: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 21>(v));
-	case 218: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 4>(v));
-	case 219: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 13>(v));
-	case 220: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 1>(v));
-	case 221: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 13>(v));
-	case 222: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 0>(v));
-	case 223: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 5>(v));
-	case 224: return get_mc_area_case<5, 0>(get_rotated_vals<fType, 22>(v));
-	case 225: return get_mc_area_case<12, 1>(get_rotated_vals<fType, 22>(v));
-	case 226: return get_mc_area_case<14, 0>(get_rotated_vals<fType, 12>(v));
-	case 227: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 8>(v));
-	case 228: return get_mc_area_case<9, 0>(get_rotated_vals<fType, 12>(v));
-	case 229: return get_mc_area_case<15, 0>(get_rotated_vals<fType, 12>(v));
-	case 230: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 17>(v));
-	case 231: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 7>(v));
-	case 232: return get_mc_area_case<11, 1>(get_rotated_vals<fType, 3>(v));
-	case 233: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 12>(v));
-	case 234: return get_mc_area_case<16, 0>(get_rotated_vals<fType, 4>(v));
-	case 235: return get_mc_area_case<18, 0>(get_rotated_vals<fType, 8>(v));
-	case 236: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 13>(v));
-	case 237: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 4>(v));
-	case 238: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 10>(v));
-	case 239: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 1>(v));
-	case 240: return get_mc_area_case<8, 0>(get_rotated_vals<fType, 23>(v));
-	case 241: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 0>(v));
-	case 242: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 9>(v));
-	case 243: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 8>(v));
-	case 244: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 8>(v));
-	case 245: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 3>(v));
-	case 246: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 7>(v));
-	case 247: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 3>(v));
-	case 248: return get_mc_area_case<17, 0>(get_rotated_vals<fType, 7>(v));
-	case 249: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 12>(v));
-	case 250: return get_mc_area_case<19, 0>(get_rotated_vals<fType, 12>(v));
-	case 251: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 8>(v));
-	case 252: return get_mc_area_case<20, 0>(get_rotated_vals<fType, 0>(v));
-	case 253: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 6>(v));
-	case 254: return get_mc_area_case<21, 0>(get_rotated_vals<fType, 0>(v));
-	case 255: return get_mc_area_case<22, 0>(get_rotated_vals<fType, 0>(v));
-	default: return 0.0;//dummy
+		return T(0.0);
+	}
+	return T(0.0);//dummy
+}
+
+//canonical case N, sub-case M and rotation R of each table index, as used by get_mc_vol/get_mc_area,
+//and the index C of (N, M) in mc_canonical_cases
+struct MCCase
+{
+	iType N, M, R, C;
+};
+
+//the canonical cases (N, M) that occur in mc_case_table
+constexpr std::array<std::array<iType, 2>, 24> mc_canonical_cases{ {
+	{ 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 }, { 8, 0 }, { 9, 0 }, { 9, 1 },
+	{ 10, 0 }, { 11, 0 }, { 12, 0 }, { 13, 0 }, { 14, 0 }, { 15, 0 }, { 16, 0 }, { 17, 0 }, { 18, 0 }, { 19, 0 },
+	{ 20, 0 }, { 21, 0 }, { 22, 0 } } };
+
+constexpr iType get_mc_canonical_index(const iType N, const iType M)
+{
+	for (iType i = 0; i < iType(mc_canonical_cases.size()); ++i) {
+		if (mc_canonical_cases[i][0] == N && mc_canonical_cases[i][1] == M) return i;
+	}
+	return -1;
+}
+
+//table index of the corner signs of case N in the orientation of its kernel
+constexpr std::array<iType, 23> mc_canonical_table_indices{ {
+	0, 1, 3, 33, 65, 14, 67, 82, 15, 141, 170, 77, 30, 90, 142, 173, 188, 241, 190, 222, 252, 254, 255 } };
+
+//corner i of the rotated cell is corner mc_rotated_corners[R][i] of the original cell
+template<std::size_t... R>
+constexpr std::array<std::array<iType, 8>, 24> get_mc_rotated_corners_table(std::index_sequence<R...>)
+{
+	return { { get_rotated_vals<iType, iType(R)>(std::array<iType, 8>{ 0, 1, 2, 3, 4, 5, 6, 7 })... } };
+}
+
+constexpr std::array<std::array<iType, 8>, 24> mc_rotated_corners = get_mc_rotated_corners_table(std::make_index_sequence<24>());
+
+//table index of the cell rotated by R
+constexpr iType get_mc_rotated_table_index(const iType table_index, const iType R)
+{
+	iType r = 0;
+	for (iType i = 0; i < 8; ++i) r |= ((table_index >> mc_rotated_corners[R][i]) & 1) << i;
+	return r;
+}
+
+//rotation R of each table index. where the corner signs of a case are symmetric, several rotations
+//bring a table index to them, but they split the quads of the surface along different diagonals,
+//so R is part of the triangulation and kept as data. N, M and C are derived from it
+constexpr std::array<iType, 256> mc_case_rotations{ {
+	0, 0, 6, 0, 8, 12, 12, 7, 3, 7, 3, 8, 8, 9, 0, 0,
+	1, 10, 4, 13, 8, 4, 12, 8, 7, 17, 12, 19, 8, 9, 0, 22,
+	5, 0, 13, 1, 13, 4, 21, 14, 5, 7, 13, 8, 3, 9, 14, 5,
+	1, 18, 10, 13, 1, 18, 10, 16, 5, 13, 10, 3, 21, 2, 20, 20,
+	20, 0, 23, 0, 21, 21, 14, 14, 21, 11, 13, 8, 15, 0, 20, 23,
+	1, 10, 0, 13, 16, 7, 14, 19, 8, 17, 0, 1, 15, 6, 7, 17,
+	14, 23, 12, 10, 6, 6, 12, 11, 14, 1, 12, 22, 6, 17, 19, 22,
+	2, 18, 22, 20, 12, 15, 4, 19, 2, 9, 21, 2, 18, 6, 15, 2,
+	2, 15, 6, 18, 2, 21, 9, 7, 19, 4, 15, 9, 20, 0, 0, 2,
+	22, 19, 17, 13, 22, 19, 13, 14, 11, 4, 11, 6, 4, 12, 23, 14,
+	17, 7, 6, 1, 1, 19, 21, 8, 19, 4, 0, 16, 20, 0, 10, 1,
+	23, 13, 18, 15, 23, 13, 11, 21, 23, 14, 21, 21, 0, 23, 0, 20,
+	20, 20, 2, 12, 3, 3, 6, 5, 16, 4, 16, 1, 3, 10, 18, 1,
+	5, 23, 5, 3, 3, 13, 7, 5, 4, 21, 4, 13, 1, 13, 0, 5,
+	22, 22, 12, 8, 12, 12, 17, 7, 3, 12, 4, 8, 13, 4, 10, 1,
+	23, 0, 9, 8, 8, 3, 7, 3, 7, 12, 12, 8, 0, 6, 0, 0 } };
+
+//N is the case whose corner signs the rotation R brings the table index to.
+//case 9 has two triangulations of its hexagon: M = 0 is used when corner 7 is inside, M = 1 otherwise
+constexpr std::array<MCCase, 256> get_mc_case_table()
+{
+	std::array<MCCase, 256> table{};
+	for (iType i = 0; i < 256; ++i) {
+		const iType R = mc_case_rotations[i];
+		const iType r = get_mc_rotated_table_index(i, R);
+		iType N = 0;
+		while (N < iType(mc_canonical_table_indices.size()) && mc_canonical_table_indices[N] != r) ++N;
+		const iType M = N == 9 && !(i & 128) ? 1 : 0;
+		table[i] = { N, M, R, get_mc_canonical_index(N, M) };
+	}
+	return table;
+}
+
+constexpr std::array<MCCase, 256> mc_case_table = get_mc_case_table();
+
+constexpr bool is_mc_case_table_valid()
+{
+	for (const MCCase& c : mc_case_table) {
+		if (c.C < 0) return false;
+	}
+	return true;
+}
+
+static_assert(is_mc_case_table_valid(), "a rotation of mc_case_rotations does not lead to a canonical case");
+
+template<typename T>
+constexpr std::array<T, 8> get_rotated_vals(const std::array<T, 8>& v, const iType R)
+{
+	const std::array<iType, 8>& r = mc_rotated_corners[R];
+	return { v[r[0]], v[r[1]], v[r[2]], v[r[3]], v[r[4]], v[r[5]], v[r[6]], v[r[7]] };
+}
+
+//mc_rotated_edges<R> for a rotation R known at runtime
+template<std::size_t... R>
+constexpr std::array<std::array<iType, 12>, 24> get_mc_rotated_edges_table(std::index_sequence<R...>)
+{
+	return { { mc_rotated_edges<iType(R)>... } };
+}
+
+constexpr std::array<std::array<iType, 12>, 24> mc_rotated_edges_table = get_mc_rotated_edges_table(std::make_index_sequence<24>());
+
+template<typename T>
+constexpr std::array<T, 12> get_rotated_vals(const std::array<T, 12>& e, const iType R)
+{
+	const std::array<iType, 12>& r = mc_rotated_edges_table[R];
+	return { e[r[0]], e[r[1]], e[r[2]], e[r[3]], e[r[4]], e[r[5]], e[r[6]], e[r[7]], e[r[8]], e[r[9]], e[r[10]], e[r[11]] };
+}
+
+//axis a of the rotated cell is axis mc_rotated_axes[R][a] of the original cell
+constexpr std::array<std::array<iType, 3>, 24> get_mc_rotated_axes_table()
+{
+	std::array<std::array<iType, 3>, 24> table{};
+	for (iType R = 0; R < 24; ++R) {
+		const std::array<iType, 8>& p = mc_rotated_corners[R];
+		const std::array<iType, 3> b{ 1, 3, 4 };//corners next to corner 0 along x, y, and z
+		for (iType a = 0; a < 3; ++a)
+			for (iType x = 0; x < 3; ++x)
+				if (mc_corners[p[0]][x] != mc_corners[p[b[a]]][x]) table[R][a] = x;
+	}
+	return table;
+}
+
+constexpr std::array<std::array<iType, 3>, 24> mc_rotated_axes = get_mc_rotated_axes_table();
+
+constexpr MCUnitSpacing get_rotated_weights(MCUnitSpacing w, const iType) { return w; }
+
+template<typename T>
+constexpr MCAreaWeights<T> get_rotated_weights(const MCAreaWeights<T>& w, const iType R)
+{
+	const T c[3] = { w.x, w.y, w.z };
+	return { c[mc_rotated_axes[R][0]], c[mc_rotated_axes[R][1]], c[mc_rotated_axes[R][2]] };
+}
+
+template<bool vol, iType N, iType M, typename B, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_kernel(const V& v, const W& w = W())
+{
+	if constexpr (vol) return get_mc_vol_case<N, M, B>(v);
+	else return get_mc_area_case<N, M, B>(v, w);
+}
+
+//kernel of the canonical case mc_canonical_cases[C] for a cell already rotated into its orientation
+template<bool vol, typename B, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_kernel(const iType C, const V& v, const W& w = W())
+{
+	switch (C) {
+	case 0: return get_mc_kernel<vol, 0, 0, B>(v, w);
+	case 1: return get_mc_kernel<vol, 1, 0, B>(v, w);
+	case 2: return get_mc_kernel<vol, 2, 0, B>(v, w);
+	case 3: return get_mc_kernel<vol, 3, 0, B>(v, w);
+	case 4: return get_mc_kernel<vol, 4, 0, B>(v, w);
+	case 5: return get_mc_kernel<vol, 5, 0, B>(v, w);
+	case 6: return get_mc_kernel<vol, 6, 0, B>(v, w);
+	case 7: return get_mc_kernel<vol, 7, 0, B>(v, w);
+	case 8: return get_mc_kernel<vol, 8, 0, B>(v, w);
+	case 9: return get_mc_kernel<vol, 9, 0, B>(v, w);
+	case 10: return get_mc_kernel<vol, 9, 1, B>(v, w);
+	case 11: return get_mc_kernel<vol, 10, 0, B>(v, w);
+	case 12: return get_mc_kernel<vol, 11, 0, B>(v, w);
+	case 13: return get_mc_kernel<vol, 12, 0, B>(v, w);
+	case 14: return get_mc_kernel<vol, 13, 0, B>(v, w);
+	case 15: return get_mc_kernel<vol, 14, 0, B>(v, w);
+	case 16: return get_mc_kernel<vol, 15, 0, B>(v, w);
+	case 17: return get_mc_kernel<vol, 16, 0, B>(v, w);
+	case 18: return get_mc_kernel<vol, 17, 0, B>(v, w);
+	case 19: return get_mc_kernel<vol, 18, 0, B>(v, w);
+	case 20: return get_mc_kernel<vol, 19, 0, B>(v, w);
+	case 21: return get_mc_kernel<vol, 20, 0, B>(v, w);
+	case 22: return get_mc_kernel<vol, 21, 0, B>(v, w);
+	case 23: return get_mc_kernel<vol, 22, 0, B>(v, w);
+	default: return typename V::value_type(0.0);//dummy
+	}
+}
+
+//kernel of table index I, with the rotation of the cell unrolled at compile time
+template<bool vol, iType I, typename B, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_case(const V& v, const W& w = W())
+{
+	constexpr MCCase c = mc_case_table[I];
+	if constexpr (vol) return get_mc_vol_case<c.N, c.M, B>(get_rotated_vals<typename V::value_type, c.R>(v));
+	else return get_mc_area_case<c.N, c.M, B>(get_rotated_vals<typename V::value_type, c.R>(v), get_rotated_weights(w, c.R));
+}
+
+//calls f(std::integral_constant<iType, I>()) for the table index I, so that f can be instantiated
+//per table index with the case data folded at compile time
+template<typename F>
+constexpr decltype(auto) visit_mc_table_index(const iType table_index, F&& f)
+{
+	switch (table_index) {
+	case 0: return f(std::integral_constant<iType, 0>());
+	case 1: return f(std::integral_constant<iType, 1>());
+	case 2: return f(std::integral_constant<iType, 2>());
+	case 3: return f(std::integral_constant<iType, 3>());
+	case 4: return f(std::integral_constant<iType, 4>());
+	case 5: return f(std::integral_constant<iType, 5>());
+	case 6: return f(std::integral_constant<iType, 6>());
+	case 7: return f(std::integral_constant<iType, 7>());
+	case 8: return f(std::integral_constant<iType, 8>());
+	case 9: return f(std::integral_constant<iType, 9>());
+	case 10: return f(std::integral_constant<iType, 10>());
+	case 11: return f(std::integral_constant<iType, 11>());
+	case 12: return f(std::integral_constant<iType, 12>());
+	case 13: return f(std::integral_constant<iType, 13>());
+	case 14: return f(std::integral_constant<iType, 14>());
+	case 15: return f(std::integral_constant<iType, 15>());
+	case 16: return f(std::integral_constant<iType, 16>());
+	case 17: return f(std::integral_constant<iType, 17>());
+	case 18: return f(std::integral_constant<iType, 18>());
+	case 19: return f(std::integral_constant<iType, 19>());
+	case 20: return f(std::integral_constant<iType, 20>());
+	case 21: return f(std::integral_constant<iType, 21>());
+	case 22: return f(std::integral_constant<iType, 22>());
+	case 23: return f(std::integral_constant<iType, 23>());
+	case 24: return f(std::integral_constant<iType, 24>());
+	case 25: return f(std::integral_constant<iType, 25>());
+	case 26: return f(std::integral_constant<iType, 26>());
+	case 27: return f(std::integral_constant<iType, 27>());
+	case 28: return f(std::integral_constant<iType, 28>());
+	case 29: return f(std::integral_constant<iType, 29>());
+	case 30: return f(std::integral_constant<iType, 30>());
+	case 31: return f(std::integral_constant<iType, 31>());
+	case 32: return f(std::integral_constant<iType, 32>());
+	case 33: return f(std::integral_constant<iType, 33>());
+	case 34: return f(std::integral_constant<iType, 34>());
+	case 35: return f(std::integral_constant<iType, 35>());
+	case 36: return f(std::integral_constant<iType, 36>());
+	case 37: return f(std::integral_constant<iType, 37>());
+	case 38: return f(std::integral_constant<iType, 38>());
+	case 39: return f(std::integral_constant<iType, 39>());
+	case 40: return f(std::integral_constant<iType, 40>());
+	case 41: return f(std::integral_constant<iType, 41>());
+	case 42: return f(std::integral_constant<iType, 42>());
+	case 43: return f(std::integral_constant<iType, 43>());
+	case 44: return f(std::integral_constant<iType, 44>());
+	case 45: return f(std::integral_constant<iType, 45>());
+	case 46: return f(std::integral_constant<iType, 46>());
+	case 47: return f(std::integral_constant<iType, 47>());
+	case 48: return f(std::integral_constant<iType, 48>());
+	case 49: return f(std::integral_constant<iType, 49>());
+	case 50: return f(std::integral_constant<iType, 50>());
+	case 51: return f(std::integral_constant<iType, 51>());
+	case 52: return f(std::integral_constant<iType, 52>());
+	case 53: return f(std::integral_constant<iType, 53>());
+	case 54: return f(std::integral_constant<iType, 54>());
+	case 55: return f(std::integral_constant<iType, 55>());
+	case 56: return f(std::integral_constant<iType, 56>());
+	case 57: return f(std::integral_constant<iType, 57>());
+	case 58: return f(std::integral_constant<iType, 58>());
+	case 59: return f(std::integral_constant<iType, 59>());
+	case 60: return f(std::integral_constant<iType, 60>());
+	case 61: return f(std::integral_constant<iType, 61>());
+	case 62: return f(std::integral_constant<iType, 62>());
+	case 63: return f(std::integral_constant<iType, 63>());
+	case 64: return f(std::integral_constant<iType, 64>());
+	case 65: return f(std::integral_constant<iType, 65>());
+	case 66: return f(std::integral_constant<iType, 66>());
+	case 67: return f(std::integral_constant<iType, 67>());
+	case 68: return f(std::integral_constant<iType, 68>());
+	case 69: return f(std::integral_constant<iType, 69>());
+	case 70: return f(std::integral_constant<iType, 70>());
+	case 71: return f(std::integral_constant<iType, 71>());
+	case 72: return f(std::integral_constant<iType, 72>());
+	case 73: return f(std::integral_constant<iType, 73>());
+	case 74: return f(std::integral_constant<iType, 74>());
+	case 75: return f(std::integral_constant<iType, 75>());
+	case 76: return f(std::integral_constant<iType, 76>());
+	case 77: return f(std::integral_constant<iType, 77>());
+	case 78: return f(std::integral_constant<iType, 78>());
+	case 79: return f(std::integral_constant<iType, 79>());
+	case 80: return f(std::integral_constant<iType, 80>());
+	case 81: return f(std::integral_constant<iType, 81>());
+	case 82: return f(std::integral_constant<iType, 82>());
+	case 83: return f(std::integral_constant<iType, 83>());
+	case 84: return f(std::integral_constant<iType, 84>());
+	case 85: return f(std::integral_constant<iType, 85>());
+	case 86: return f(std::integral_constant<iType, 86>());
+	case 87: return f(std::integral_constant<iType, 87>());
+	case 88: return f(std::integral_constant<iType, 88>());
+	case 89: return f(std::integral_constant<iType, 89>());
+	case 90: return f(std::integral_constant<iType, 90>());
+	case 91: return f(std::integral_constant<iType, 91>());
+	case 92: return f(std::integral_constant<iType, 92>());
+	case 93: return f(std::integral_constant<iType, 93>());
+	case 94: return f(std::integral_constant<iType, 94>());
+	case 95: return f(std::integral_constant<iType, 95>());
+	case 96: return f(std::integral_constant<iType, 96>());
+	case 97: return f(std::integral_constant<iType, 97>());
+	case 98: return f(std::integral_constant<iType, 98>());
+	case 99: return f(std::integral_constant<iType, 99>());
+	case 100: return f(std::integral_constant<iType, 100>());
+	case 101: return f(std::integral_constant<iType, 101>());
+	case 102: return f(std::integral_constant<iType, 102>());
+	case 103: return f(std::integral_constant<iType, 103>());
+	case 104: return f(std::integral_constant<iType, 104>());
+	case 105: return f(std::integral_constant<iType, 105>());
+	case 106: return f(std::integral_constant<iType, 106>());
+	case 107: return f(std::integral_constant<iType, 107>());
+	case 108: return f(std::integral_constant<iType, 108>());
+	case 109: return f(std::integral_constant<iType, 109>());
+	case 110: return f(std::integral_constant<iType, 110>());
+	case 111: return f(std::integral_constant<iType, 111>());
+	case 112: return f(std::integral_constant<iType, 112>());
+	case 113: return f(std::integral_constant<iType, 113>());
+	case 114: return f(std::integral_constant<iType, 114>());
+	case 115: return f(std::integral_constant<iType, 115>());
+	case 116: return f(std::integral_constant<iType, 116>());
+	case 117: return f(std::integral_constant<iType, 117>());
+	case 118: return f(std::integral_constant<iType, 118>());
+	case 119: return f(std::integral_constant<iType, 119>());
+	case 120: return f(std::integral_constant<iType, 120>());
+	case 121: return f(std::integral_constant<iType, 121>());
+	case 122: return f(std::integral_constant<iType, 122>());
+	case 123: return f(std::integral_constant<iType, 123>());
+	case 124: return f(std::integral_constant<iType, 124>());
+	case 125: return f(std::integral_constant<iType, 125>());
+	case 126: return f(std::integral_constant<iType, 126>());
+	case 127: return f(std::integral_constant<iType, 127>());
+	case 128: return f(std::integral_constant<iType, 128>());
+	case 129: return f(std::integral_constant<iType, 129>());
+	case 130: return f(std::integral_constant<iType, 130>());
+	case 131: return f(std::integral_constant<iType, 131>());
+	case 132: return f(std::integral_constant<iType, 132>());
+	case 133: return f(std::integral_constant<iType, 133>());
+	case 134: return f(std::integral_constant<iType, 134>());
+	case 135: return f(std::integral_constant<iType, 135>());
+	case 136: return f(std::integral_constant<iType, 136>());
+	case 137: return f(std::integral_constant<iType, 137>());
+	case 138: return f(std::integral_constant<iType, 138>());
+	case 139: return f(std::integral_constant<iType, 139>());
+	case 140: return f(std::integral_constant<iType, 140>());
+	case 141: return f(std::integral_constant<iType, 141>());
+	case 142: return f(std::integral_constant<iType, 142>());
+	case 143: return f(std::integral_constant<iType, 143>());
+	case 144: return f(std::integral_constant<iType, 144>());
+	case 145: return f(std::integral_constant<iType, 145>());
+	case 146: return f(std::integral_constant<iType, 146>());
+	case 147: return f(std::integral_constant<iType, 147>());
+	case 148: return f(std::integral_constant<iType, 148>());
+	case 149: return f(std::integral_constant<iType, 149>());
+	case 150: return f(std::integral_constant<iType, 150>());
+	case 151: return f(std::integral_constant<iType, 151>());
+	case 152: return f(std::integral_constant<iType, 152>());
+	case 153: return f(std::integral_constant<iType, 153>());
+	case 154: return f(std::integral_constant<iType, 154>());
+	case 155: return f(std::integral_constant<iType, 155>());
+	case 156: return f(std::integral_constant<iType, 156>());
+	case 157: return f(std::integral_constant<iType, 157>());
+	case 158: return f(std::integral_constant<iType, 158>());
+	case 159: return f(std::integral_constant<iType, 159>());
+	case 160: return f(std::integral_constant<iType, 160>());
+	case 161: return f(std::integral_constant<iType, 161>());
+	case 162: return f(std::integral_constant<iType, 162>());
+	case 163: return f(std::integral_constant<iType, 163>());
+	case 164: return f(std::integral_constant<iType, 164>());
+	case 165: return f(std::integral_constant<iType, 165>());
+	case 166: return f(std::integral_constant<iType, 166>());
+	case 167: return f(std::integral_constant<iType, 167>());
+	case 168: return f(std::integral_constant<iType, 168>());
+	case 169: return f(std::integral_constant<iType, 169>());
+	case 170: return f(std::integral_constant<iType, 170>());
+	case 171: return f(std::integral_constant<iType, 171>());
+	case 172: return f(std::integral_constant<iType, 172>());
+	case 173: return f(std::integral_constant<iType, 173>());
+	case 174: return f(std::integral_constant<iType, 174>());
+	case 175: return f(std::integral_constant<iType, 175>());
+	case 176: return f(std::integral_constant<iType, 176>());
+	case 177: return f(std::integral_constant<iType, 177>());
+	case 178: return f(std::integral_constant<iType, 178>());
+	case 179: return f(std::integral_constant<iType, 179>());
+	case 180: return f(std::integral_constant<iType, 180>());
+	case 181: return f(std::integral_constant<iType, 181>());
+	case 182: return f(std::integral_constant<iType, 182>());
+	case 183: return f(std::integral_constant<iType, 183>());
+	case 184: return f(std::integral_constant<iType, 184>());
+	case 185: return f(std::integral_constant<iType, 185>());
+	case 186: return f(std::integral_constant<iType, 186>());
+	case 187: return f(std::integral_constant<iType, 187>());
+	case 188: return f(std::integral_constant<iType, 188>());
+	case 189: return f(std::integral_constant<iType, 189>());
+	case 190: return f(std::integral_constant<iType, 190>());
+	case 191: return f(std::integral_constant<iType, 191>());
+	case 192: return f(std::integral_constant<iType, 192>());
+	case 193: return f(std::integral_constant<iType, 193>());
+	case 194: return f(std::integral_constant<iType, 194>());
+	case 195: return f(std::integral_constant<iType, 195>());
+	case 196: return f(std::integral_constant<iType, 196>());
+	case 197: return f(std::integral_constant<iType, 197>());
+	case 198: return f(std::integral_constant<iType, 198>());
+	case 199: return f(std::integral_constant<iType, 199>());
+	case 200: return f(std::integral_constant<iType, 200>());
+	case 201: return f(std::integral_constant<iType, 201>());
+	case 202: return f(std::integral_constant<iType, 202>());
+	case 203: return f(std::integral_constant<iType, 203>());
+	case 204: return f(std::integral_constant<iType, 204>());
+	case 205: return f(std::integral_constant<iType, 205>());
+	case 206: return f(std::integral_constant<iType, 206>());
+	case 207: return f(std::integral_constant<iType, 207>());
+	case 208: return f(std::integral_constant<iType, 208>());
+	case 209: return f(std::integral_constant<iType, 209>());
+	case 210: return f(std::integral_constant<iType, 210>());
+	case 211: return f(std::integral_constant<iType, 211>());
+	case 212: return f(std::integral_constant<iType, 212>());
+	case 213: return f(std::integral_constant<iType, 213>());
+	case 214: return f(std::integral_constant<iType, 214>());
+	case 215: return f(std::integral_constant<iType, 215>());
+	case 216: return f(std::integral_constant<iType, 216>());
+	case 217: return f(std::integral_constant<iType, 217>());
+	case 218: return f(std::integral_constant<iType, 218>());
+	case 219: return f(std::integral_constant<iType, 219>());
+	case 220: return f(std::integral_constant<iType, 220>());
+	case 221: return f(std::integral_constant<iType, 221>());
+	case 222: return f(std::integral_constant<iType, 222>());
+	case 223: return f(std::integral_constant<iType, 223>());
+	case 224: return f(std::integral_constant<iType, 224>());
+	case 225: return f(std::integral_constant<iType, 225>());
+	case 226: return f(std::integral_constant<iType, 226>());
+	case 227: return f(std::integral_constant<iType, 227>());
+	case 228: return f(std::integral_constant<iType, 228>());
+	case 229: return f(std::integral_constant<iType, 229>());
+	case 230: return f(std::integral_constant<iType, 230>());
+	case 231: return f(std::integral_constant<iType, 231>());
+	case 232: return f(std::integral_constant<iType, 232>());
+	case 233: return f(std::integral_constant<iType, 233>());
+	case 234: return f(std::integral_constant<iType, 234>());
+	case 235: return f(std::integral_constant<iType, 235>());
+	case 236: return f(std::integral_constant<iType, 236>());
+	case 237: return f(std::integral_constant<iType, 237>());
+	case 238: return f(std::integral_constant<iType, 238>());
+	case 239: return f(std::integral_constant<iType, 239>());
+	case 240: return f(std::integral_constant<iType, 240>());
+	case 241: return f(std::integral_constant<iType, 241>());
+	case 242: return f(std::integral_constant<iType, 242>());
+	case 243: return f(std::integral_constant<iType, 243>());
+	case 244: return f(std::integral_constant<iType, 244>());
+	case 245: return f(std::integral_constant<iType, 245>());
+	case 246: return f(std::integral_constant<iType, 246>());
+	case 247: return f(std::integral_constant<iType, 247>());
+	case 248: return f(std::integral_constant<iType, 248>());
+	case 249: return f(std::integral_constant<iType, 249>());
+	case 250: return f(std::integral_constant<iType, 250>());
+	case 251: return f(std::integral_constant<iType, 251>());
+	case 252: return f(std::integral_constant<iType, 252>());
+	case 253: return f(std::integral_constant<iType, 253>());
+	case 254: return f(std::integral_constant<iType, 254>());
+	case 255: return f(std::integral_constant<iType, 255>());
+	default: return f(std::integral_constant<iType, 0>());//dummy
+	}
+}
+
+//the cell is rotated at runtime by mc_rotated_corners/mc_rotated_edges_table into the orientation of its
+//canonical case, so only the 24 canonical kernels are instantiated
+template<bool vol, typename B, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_case_compact(const iType table_index, const V& v, const W& w = W())
+{
+	const MCCase& c = mc_case_table[table_index];
+	return get_mc_kernel<vol, B>(c.C, c.R == 0 ? v : get_rotated_vals(v, c.R), get_rotated_weights(w, c.R));
+}
+
+//the switch over the table index inlines the rotation of each of the 256 indices, which is faster
+//on corner values (about 1.3x) but has more than twice the code
+template<bool vol, typename B, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_case_switch(const iType table_index, const V& v, const W& w = W())
+{
+	return visit_mc_table_index(table_index, [&v, &w](auto I) { return get_mc_case<vol, decltype(I)::value, B>(v, w); });
+}
+
+//get_mc_case_compact by default; define FRACTION_MC_SWITCH to use get_mc_case_switch. both give bitwise identical results
+template<bool vol, typename B, typename V, typename W = MCUnitSpacing>
+constexpr typename V::value_type get_mc_case(const iType table_index, const V& v, const W& w = W())
+{
+#ifdef FRACTION_MC_SWITCH
+	return get_mc_case_switch<vol, B>(table_index, v, w);
+#else
+	return get_mc_case_compact<vol, B>(table_index, v, w);
+#endif
+}
+
+//=================================================================================================
+//		statistics
+//=================================================================================================
+
+//opt-in counters of get_mc_vol/get_mc_area, compiled only when FRACTION_STATS is defined
+//(the dispatchers are then no longer constexpr). every thread counts the table indices of its calls
+//into its own MCThreadStats, and get_mc_stats() merges the counters of all threads on demand.
+//with FRACTION_STATS_TIMING, every mc_stats_sample_period-th call of each table index is also timed,
+//in rdtsc cycles on x86 and in steady_clock nanoseconds elsewhere
+#ifdef FRACTION_STATS
+#define FRACTION_MC_CONSTEXPR
+
+constexpr std::uint64_t mc_stats_sample_period = 64;
+
+//merged counters of get_mc_vol (vol) and get_mc_area (area) per table index
+struct MCStats
+{
+	struct Counters
+	{
+		std::array<std::uint64_t, 256> count{};//calls
+		std::array<std::uint64_t, 256> samples{};//timed calls
+		std::array<std::uint64_t, 256> ticks{};//ticks of the timed calls
+	};
+	Counters vol, area;
+};
+
+//counters of one thread; only the owner writes them, so relaxed loads and stores suffice
+struct MCThreadStats
+{
+	struct Counters
+	{
+		std::array<std::atomic<std::uint64_t>, 256> count{}, samples{}, ticks{};
+	};
+	Counters vol, area;
+};
+
+struct MCStatsRegistry
+{
+	std::mutex mutex;
+	std::vector<std::shared_ptr<MCThreadStats>> threads;//kept after the threads exit
+};
+
+inline MCStatsRegistry& get_mc_stats_registry()
+{
+	static MCStatsRegistry registry;
+	return registry;
+}
+
+inline MCThreadStats& get_thread_mc_stats()
+{
+	thread_local const std::shared_ptr<MCThreadStats> stats = []() {
+		const std::shared_ptr<MCThreadStats> s = std::make_shared<MCThreadStats>();
+		MCStatsRegistry& registry = get_mc_stats_registry();
+		const std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.threads.push_back(s);
+		return s;
+	}();
+	return *stats;
+}
+
+inline std::uint64_t get_mc_stats_ticks()
+{
+#ifdef FRACTION_STATS_RDTSC
+	return __rdtsc();
+#else
+	return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline void add_relaxed(std::atomic<std::uint64_t>& c, const std::uint64_t n)
+{
+	c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+//counts a call of table index i, and times it if it is sampled
+struct MCStatsScope
+{
+	MCThreadStats::Counters& counters;
+	const iType i;
+	std::uint64_t start = 0;
+
+	MCStatsScope(MCThreadStats::Counters& counters, const iType i) : counters(counters), i(i)
+	{
+		const std::uint64_t n = counters.count[i].load(std::memory_order_relaxed);
+		counters.count[i].store(n + 1, std::memory_order_relaxed);
+#ifdef FRACTION_STATS_TIMING
+		if (n % mc_stats_sample_period == 0) start = get_mc_stats_ticks();
+#endif
+	}
+
+	~MCStatsScope()
+	{
+#ifdef FRACTION_STATS_TIMING
+		if (start == 0) return;
+		add_relaxed(counters.ticks[i], get_mc_stats_ticks() - start);
+		add_relaxed(counters.samples[i], 1);
+#endif
+	}
+};
+
+inline MCStats get_mc_stats()
+{
+	MCStats stats;
+	const auto merge = [](MCStats::Counters& to, const MCThreadStats::Counters& from) {
+		for (std::size_t i = 0; i < 256; ++i) {
+			to.count[i] += from.count[i].load(std::memory_order_relaxed);
+			to.samples[i] += from.samples[i].load(std::memory_order_relaxed);
+			to.ticks[i] += from.ticks[i].load(std::memory_order_relaxed);
+		}
+	};
+	MCStatsRegistry& registry = get_mc_stats_registry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+	for (const std::shared_ptr<MCThreadStats>& t : registry.threads) {
+		merge(stats.vol, t->vol);
+		merge(stats.area, t->area);
+	}
+	return stats;
+}
+
+//resets the counters of all threads; calls running concurrently may be lost
+inline void reset_mc_stats()
+{
+	const auto reset = [](MCThreadStats::Counters& c) {
+		for (std::size_t i = 0; i < 256; ++i) {
+			c.count[i].store(0, std::memory_order_relaxed);
+			c.samples[i].store(0, std::memory_order_relaxed);
+			c.ticks[i].store(0, std::memory_order_relaxed);
+		}
+	};
+	MCStatsRegistry& registry = get_mc_stats_registry();
+	const std::lock_guard<std::mutex> lock(registry.mutex);
+	for (const std::shared_ptr<MCThreadStats>& t : registry.threads) {
+		reset(t->vol);
+		reset(t->area);
+	}
+}
+
+//the counters as JSON: per table index (with its canonical case N, M and rotation R) and per canonical case.
+//ticks_per_call is -1 when no call was timed
+inline std::string get_mc_stats_json(const MCStats& stats)
+{
+	const auto ticks_per_call = [](const std::uint64_t ticks, const std::uint64_t samples) {
+		return samples > 0 ? double(ticks) / double(samples) : -1.0;
+	};
+	const auto counters_json = [&](const MCStats::Counters& c) {
+		std::string s;
+		char buf[160];
+		std::uint64_t calls = 0;
+		std::array<std::uint64_t, mc_canonical_cases.size()> case_count{}, case_samples{}, case_ticks{};
+		for (iType i = 0; i < 256; ++i) {
+			calls += c.count[i];
+			const iType b = mc_case_table[i].C;
+			case_count[b] += c.count[i];
+			case_samples[b] += c.samples[i];
+			case_ticks[b] += c.ticks[i];
+		}
+		std::snprintf(buf, sizeof(buf), "{ \"calls\": %llu, \"table_index\": [", (unsigned long long)calls);
+		s += buf;
+		const char* sep = "\n";
+		for (iType i = 0; i < 256; ++i) {
+			if (c.count[i] == 0) continue;
+			std::snprintf(buf, sizeof(buf), "%s      { \"index\": %d, \"N\": %d, \"M\": %d, \"R\": %d, \"count\": %llu, \"ticks_per_call\": %.1f }",
+				sep, i, mc_case_table[i].N, mc_case_table[i].M, mc_case_table[i].R, (unsigned long long)c.count[i], ticks_per_call(c.ticks[i], c.samples[i]));
+			s += buf;
+			sep = ",\n";
+		}
+		s += " ],\n    \"cases\": [";
+		sep = "\n";
+		for (std::size_t b = 0; b < mc_canonical_cases.size(); ++b) {
+			if (case_count[b] == 0) continue;
+			std::snprintf(buf, sizeof(buf), "%s      { \"N\": %d, \"M\": %d, \"count\": %llu, \"ticks_per_call\": %.1f }",
+				sep, mc_canonical_cases[b][0], mc_canonical_cases[b][1], (unsigned long long)case_count[b], ticks_per_call(case_ticks[b], case_samples[b]));
+			s += buf;
+			sep = ",\n";
+		}
+		return s + " ] }";
+	};
+#ifdef FRACTION_STATS_RDTSC
+	const char* unit = "rdtsc";
+#else
+	const char* unit = "ns";
+#endif
+	return std::string("{\n  \"ticks\": \"") + unit + "\",\n  \"sample_period\": " + std::to_string(mc_stats_sample_period) +
+		",\n  \"vol\": " + counters_json(stats.vol) + ",\n  \"area\": " + counters_json(stats.area) + "\n}\n";
+}
+#else
+#define FRACTION_MC_CONSTEXPR constexpr
+#endif
+
+template<typename B = MCBackend, typename V>
+FRACTION_MC_CONSTEXPR typename V::value_type get_mc_vol(const iType table_index, const V& v)
+{
+#ifdef FRACTION_STATS
+	const MCStatsScope scope(get_thread_mc_stats().vol, table_index);
+#endif
+	return get_mc_case<true, B>(table_index, v);
+}
+
+template<typename B = MCBackend, typename T = fType>
+FRACTION_MC_CONSTEXPR T get_mc_vol(const std::array<T, 8>& v)
+{
+	return get_mc_vol<B>(get_mc_table_index(v), v);
+}
+
+template<typename B = MCBackend, typename V>
+FRACTION_MC_CONSTEXPR typename V::value_type get_mc_area(const iType table_index, const V& v)
+{
+#ifdef FRACTION_STATS
+	const MCStatsScope scope(get_thread_mc_stats().area, table_index);
+#endif
+	return get_mc_case<false, B>(table_index, v);
+}
+
+template<typename B = MCBackend, typename T = fType>
+FRACTION_MC_CONSTEXPR T get_mc_area(const std::array<T, 8>& v)
+{
+	return get_mc_area<B>(get_mc_table_index(v), v);
+}
+
+//volume and area in world units of a cell with the spacing s (see MCSpacing).
+//the isotropic spacings only scale the results of the unit-cube kernels
+template<typename T>
+constexpr T get_mc_cell_vol(MCUnitSpacing) { return T(1.0); }
+
+template<typename T, typename S>
+constexpr T get_mc_cell_vol(const MCIsoSpacing<S>& s) { return T(s.h * s.h * s.h); }
+
+template<typename T, typename S>
+constexpr T get_mc_cell_vol(const MCSpacing<S>& s) { return T(s.dx * s.dy * s.dz); }
+
+template<typename B = MCBackend, typename V, typename S>
+FRACTION_MC_CONSTEXPR typename V::value_type get_mc_vol(const iType table_index, const V& v, const S& s)
+{
+	return get_mc_cell_vol<typename V::value_type>(s) * get_mc_vol<B>(table_index, v);
+}
+
+template<typename B = MCBackend, typename V>
+FRACTION_MC_CONSTEXPR typename V::value_type get_mc_area(const iType table_index, const V& v, MCUnitSpacing)
+{
+	return get_mc_area<B>(table_index, v);
+}
+
+template<typename B = MCBackend, typename V, typename S>
+FRACTION_MC_CONSTEXPR typename V::value_type get_mc_area(const iType table_index, const V& v, const MCIsoSpacing<S>& s)
+{
+	using T = typename V::value_type;
+	return T(s.h * s.h) * get_mc_area<B>(table_index, v);
+}
+
+template<typename B = MCBackend, typename V, typename S>
+FRACTION_MC_CONSTEXPR typename V::value_type get_mc_area(const iType table_index, const V& v, const MCSpacing<S>& s)
+{
+	using T = typename V::value_type;
+#ifdef FRACTION_STATS
+	const MCStatsScope scope(get_thread_mc_stats().area, table_index);
+#endif
+	return get_mc_case<false, B>(table_index, v, MCAreaWeights<T>{ T(s.dy * s.dz), T(s.dx * s.dz), T(s.dx * s.dy) });
+}
+
+template<typename B = MCBackend, typename T = fType, typename S>
+FRACTION_MC_CONSTEXPR T get_mc_vol(const std::array<T, 8>& v, const S& s)
+{
+	return get_mc_vol<B>(get_mc_table_index(v), v, s);
+}
+
+template<typename B = MCBackend, typename T = fType, typename S>
+FRACTION_MC_CONSTEXPR T get_mc_area(const std::array<T, 8>& v, const S& s)
+{
+	return get_mc_area<B>(get_mc_table_index(v), v, s);
+}
+
+//=================================================================================================
+//		approximate volume
+//=================================================================================================
+
+//quadratic least-squares fit of get_mc_vol_case in the edge fractions of the crossing edges of a canonical
+//case, for the cases whose exact volume needs several sv terms (num == 0 for the others).
+//c holds the constant, the linear terms, and the products x_a x_b (a <= b) in this order
+struct MCVolFit
+{
+	iType num;
+	std::array<iType, 9> edges;
+	std::array<fType, 55> c;
+};
+
+constexpr std::array<MCVolFit, 24> mc_vol_fits{ {
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 6, { 0, 1, 6, 7, 8, 10 }, {
+		0.135314, 0.04375961, 0.2038648, 0.04521765, 0.200055, 0.2013782, 0.03585983, 0.001632131, -0.05374926, -0.0007119741,
+		0.016077, 0.05086673, -0.01439142, -0.0264788, -0.01520602, -0.0002629302, -0.08324507, 0.200928, -0.0006770295, 0.05272337,
+		0.01437947, -0.05141028, 0.02636975, -0.2010677, 0.08282788, 0.02635117, 0.0003202147, -0.02675016 } },
+	{ 6, { 0, 1, 6, 7, 8, 10 }, {
+		0.1355904, 0.2012017, 0.04646346, 0.2012562, 0.04390241, 0.0373724, 0.1986173, -0.02383652, -0.05562928, -0.002929694,
+		-0.01212513, 0.1978395, -0.07901275, 0.0003345068, 0.01643807, -0.002075713, -0.01249595, 0.04970343, 0.02837461, 0.04968288,
+		0.08523036, -0.2042321, 0.0006372545, -0.05349167, 0.01748798, -0.02591319, -0.003004925, 0.02893 } },
+	{ 0, {}, {} },
+	{ 6, { 0, 1, 5, 6, 8, 11 }, {
+		0.1306721, 0.04195353, 0.1669213, 0.2394483, 0.04518077, -0.000108637, 0.2458262, -0.0001859584, -0.1664644, -0.08336339,
+		-0.0001282084, 0.1667159, 0.08311683, -0.0001867904, 7.542013e-06, 1.420274e-05, -0.0001799681, -9.682788e-05, 0.01257721, 0.06453856,
+		-0.0001505012, -0.0001750605, -0.0003011022, -1.231102e-07, -0.06412274, 1.277889e-05, 0.0003724725, -0.01298913 } },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 6, { 0, 3, 6, 7, 9, 10 }, {
+		0.1307468, 0.04174221, 0.1666799, 0.04508511, 0.2391712, -4.732037e-06, 0.2461091, -0.0002141189, -0.1665415, -0.0003131463,
+		-0.08300923, 0.1667312, 0.08344361, 1.960839e-05, 3.077905e-06, 0.0001184667, -0.0001297471, -0.0001473473, 0.0001773069, 0.06429437,
+		0.0001491695, -0.06436541, 0.01271219, -0.0001349273, -0.000198417, 2.741565e-05, -1.514986e-05, -0.01312152 } },
+	{ 9, { 0, 1, 4, 5, 6, 7, 8, 9, 10 }, {
+		0.1442145, 0.1895193, 0.1911747, -0.03263714, -0.03030097, 0.03354228, 0.2016867, 0.05008263, -0.008349475, 0.04860452,
+		0.0252523, -0.1770316, -0.008267477, 0.003559298, -0.001817031, -0.0710016, 0.05468232, -0.009995557, 0.005575584, 0.02279143,
+		-0.0008163499, -0.004847819, 0.0900294, 0.002436156, 0.004381597, -0.007495096, 0.05731592, -0.01348753, 0.05916905, 0.008167832,
+		-0.001083682, 0.01909915, 0.08824685, 0.002303031, -0.008787427, -0.00639702, 0.01221086, -0.004508125, 0.07949949, 0.01426692,
+		-0.009887877, 0.1735487, 0.003407615, -0.002958305, -0.07289262, -0.009868979, -0.07931753, -0.01346384, -0.001591412, 0.003061865,
+		0.002274244, -0.00365249, -0.002327196, -0.001142206, 0.00252702 } },
+	{ 7, { 1, 3, 5, 6, 8, 9, 10 }, {
+		-0.05614892, 0.199735, 0.2128348, 0.04770077, 0.2880165, 0.2131959, 0.1997966, 0.04836584, 0.02209056, 0.0001158345,
+		-0.005534502, -0.08388932, -0.0003980579, -0.02095773, 0.06953005, 8.582245e-05, 0.0001799815, 0.07379616, -0.08318536, -3.233512e-05,
+		4.116065e-05, -0.01473113, -0.06976866, -8.867108e-05, 0.06953965, 0.02825984, -0.01806184, 0.07355677, -0.08299991, -0.06982731,
+		3.08984e-05, 7.863849e-05, 0.0001064759, 0.0220414, -0.006594589, -0.01476924 } },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 6, { 0, 3, 4, 5, 8, 9 }, {
+		0.2986605, 0.1981381, 0.3402721, 0.04930802, 0.4089645, 0.1983068, 0.04848845, 0.02222886, -0.1703414, -0.009383681,
+		-0.07934787, -0.01538587, 0.0697828, 0.0008189701, 0.004200508, -0.009546893, -0.1733963, 0.001090735, -0.01443131, -0.07240799,
+		0.06755688, 0.02874196, -0.01642657, -0.07882593, -0.07102822, 0.0236582, -0.00788723, -0.01456368 } },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	{ 0, {}, {} },
+	} };
+
+//bound of |get_mc_vol_approx - get_mc_vol| per cell. the largest error measured on 10^5 random cells of
+//each fitted table index is 0.056 (case (16, 0)) and 0.035 to 0.050 for the other fitted cases,
+//which bench checks on every run
+constexpr fType mc_vol_approx_error = 0.06;
+
+//fraction of the canonical edge mc_vol_fits[C].edges[a] of table index I, from the edge fractions or the corner values
+template<iType I, iType a, typename V>
+constexpr typename V::value_type get_mc_vol_fit_frac(const V& v)
+{
+	constexpr MCCase c = mc_case_table[I];
+	constexpr iType k = mc_rotated_edges_table[c.R][mc_vol_fits[c.C].edges[a]];
+	if constexpr (std::tuple_size<V>::value == 12) return v[k];
+	else return get_len_frac(v[mc_edges[k][0]], v[mc_edges[k][1]]);
+}
+
+//index of the coefficient of x_i x_j (i <= j) of a fit with n fractions
+constexpr iType get_mc_vol_fit_term(const iType n, const iType i, const iType j)
+{
+	return 1 + n + i * n - i * (i - 1) / 2 + (j - i);
+}
+
+//row i of the quadratic form, c_i + sum of c_ij x_j over j >= i
+template<iType C, iType i, typename T, std::size_t n, iType... j>
+inline T get_mc_vol_fit_row(const std::array<T, n>& x, std::integer_sequence<iType, j...>)
+{
+	return (T(mc_vol_fits[C].c[1 + i]) + ... + (T(mc_vol_fits[C].c[get_mc_vol_fit_term(n, i, i + j)]) * x[i + j]));
+}
+
+//the fit of table index I, unrolled at compile time so that the rows are evaluated independently,
+//and clamped to [0, 1]
+template<iType I, typename V, iType... i>
+inline typename V::value_type get_mc_vol_fit(const V& v, std::integer_sequence<iType, i...>)
+{
+	using T = typename V::value_type;
+	constexpr iType C = mc_case_table[I].C;
+	const std::array<T, sizeof...(i)> x{ get_mc_vol_fit_frac<I, i>(v)... };
+	const T vol = (T(mc_vol_fits[C].c[0]) + ... +
+		(get_mc_vol_fit_row<C, i>(x, std::make_integer_sequence<iType, iType(sizeof...(i)) - i>()) * x[i]));
+	return std::min(std::max(vol, T(0.0)), T(1.0));
+}
+
+//opt-in approximation of get_mc_vol for in-loop monitoring: the cases with sv terms (the canonical
+//cases (9, 0), (9, 1), (11, 0), (14, 0), (15, 0), (16, 0), and (19, 0)) are replaced by mc_vol_fits,
+//and the others are evaluated exactly. the error per cell is at most mc_vol_approx_error
+template<typename B = MCBackend, typename V>
+typename V::value_type get_mc_vol_approx(const iType table_index, const V& v)
+{
+	return visit_mc_table_index(table_index, [&v](auto I) {
+		constexpr iType i = decltype(I)::value;
+		constexpr iType n = mc_vol_fits[mc_case_table[i].C].num;
+		if constexpr (n == 0) return get_mc_case<true, i, B>(v);
+		else return get_mc_vol_fit<i>(v, std::make_integer_sequence<iType, n>());
+	});
+}
+
+template<typename B = MCBackend, typename T = fType>
+T get_mc_vol_approx(const std::array<T, 8>& v)
+{
+	return get_mc_vol_approx<B>(get_mc_table_index(v), v);
+}
+
+//=================================================================================================
+//		gradients
+//=================================================================================================
+
+//value and gradient with respect to the corner values, from the kernels evaluated on MCDual
+//(with ScalarBackend). the gradient is 0 for cells that are fully inside or outside
+template<typename T = fType>
+MCDual<T, 8> get_mc_vol_grad(const std::array<T, 8>& v)
+{
+	std::array<MCDual<T, 8>, 8> x;
+	for (std::size_t i = 0; i < 8; ++i) x[i] = MCDual<T, 8>::get_input(v[i], i);
+	return get_mc_vol<ScalarBackend>(x);
+}
+
+template<typename T = fType>
+MCDual<T, 8> get_mc_area_grad(const std::array<T, 8>& v)
+{
+	std::array<MCDual<T, 8>, 8> x;
+	for (std::size_t i = 0; i < 8; ++i) x[i] = MCDual<T, 8>::get_input(v[i], i);
+	return get_mc_area<ScalarBackend>(x);
+}
+
+template<typename T = fType>
+MCDual<T, 4> get_ms_area_grad(const std::array<T, 4>& v)
+{
+	std::array<MCDual<T, 4>, 4> x;
+	for (std::size_t i = 0; i < 4; ++i) x[i] = MCDual<T, 4>::get_input(v[i], i);
+	return get_ms_area(x);
+}
+
+template<typename T = fType>
+MCDual<T, 4> get_ms_len_grad(const std::array<T, 4>& v)
+{
+	std::array<MCDual<T, 4>, 4> x;
+	for (std::size_t i = 0; i < 4; ++i) x[i] = MCDual<T, 4>::get_input(v[i], i);
+	return get_ms_len(x);
+}
+
+//=================================================================================================
+//		mc-style measures
+//=================================================================================================
+
+//surface triangles of a case as triples of edges of the cell
+struct MCTriangles
+{
+	iType num;
+	std::array<std::array<iType, 3>, 5> tri;
+};
+
+//the triangles of get_mc_area_case for each entry of mc_canonical_cases
+constexpr std::array<MCTriangles, 24> mc_canonical_triangles{ {
+	{ 0, {} },
+	{ 1, { { { 0, 8, 3 } } } },
+	{ 2, { { { 1, 8, 3 }, { 9, 8, 1 } } } },
+	{ 2, { { { 9, 5, 4 }, { 0, 8, 3 } } } },
+	{ 2, { { { 0, 8, 3 }, { 5, 10, 6 } } } },
+	{ 3, { { { 3, 9, 0 }, { 3, 11, 9 }, { 11, 10, 9 } } } },
+	{ 3, { { { 1, 8, 3 }, { 1, 9, 8 }, { 5, 10, 6 } } } },
+	{ 3, { { { 1, 9, 0 }, { 5, 10, 6 }, { 8, 4, 7 } } } },
+	{ 2, { { { 9, 8, 10 }, { 10, 8, 11 } } } },
+	{ 4, { { { 10, 7, 6 }, { 1, 7, 10 }, { 1, 8, 7 }, { 1, 0, 8 } } } },
+	{ 4, { { { 10, 1, 0 }, { 6, 10, 0 }, { 6, 0, 8 }, { 6, 8, 7 } } } },
+	{ 4, { { { 3, 6, 2 }, { 3, 7, 6 }, { 1, 5, 0 }, { 5, 4, 0 } } } },
+	{ 4, { { { 0, 8, 11 }, { 0, 11, 5 }, { 0, 5, 1 }, { 5, 11, 6 } } } },
+	{ 4, { { { 4, 7, 8 }, { 9, 0, 11 }, { 9, 11, 10 }, { 11, 0, 3 } } } },
+	{ 4, { { { 0, 1, 9 }, { 4, 7, 8 }, { 2, 3, 11 }, { 5, 10, 6 } } } },
+	{ 4, { { { 0, 3, 7 }, { 0, 7, 10 }, { 0, 10, 9 }, { 6, 10, 7 } } } },
+	{ 5, { { { 1, 6, 10 }, { 1, 7, 6 }, { 1, 0, 7 }, { 8, 7, 0 }, { 9, 5, 4 } } } },
+	{ 5, { { { 1, 3, 6 }, { 1, 6, 10 }, { 3, 8, 6 }, { 5, 6, 9 }, { 8, 9, 6 } } } },
+	{ 3, { { { 3, 0, 9 }, { 3, 9, 11 }, { 11, 9, 10 } } } },
+	{ 2, { { { 0, 3, 8 }, { 5, 6, 10 } } } },
+	{ 4, { { { 8, 4, 5 }, { 8, 5, 3 }, { 9, 0, 5 }, { 0, 3, 5 } } } },
+	{ 2, { { { 1, 3, 8 }, { 9, 1, 8 } } } },
+	{ 1, { { { 0, 3, 8 } } } },
+	{ 0, {} } } };
+
+//the canonical triangles rotated back into each table index, with the vertex order chosen
+//so that the normal (p1 - p0) x (p2 - p0) points from the inside to the outside.
+//the orientation is decided with the vertices at the edge midpoints, where it cannot degenerate
+constexpr std::array<MCTriangles, 256> get_mc_triangle_table()
+{
+	std::array<MCTriangles, 256> table{};
+	for (iType i = 0; i < 256; ++i) {
+		const MCCase& c = mc_case_table[i];
+		const MCTriangles& t = mc_canonical_triangles[c.C];
+		table[i].num = t.num;
+		for (iType n = 0; n < t.num; ++n) {
+			std::array<iType, 3> tri{};
+			std::array<std::array<iType, 3>, 3> p{};//twice the midpoints
+			std::array<iType, 3> d{};//sum of the edge directions from the inside to the outside corner
+			for (iType l = 0; l < 3; ++l) {
+				tri[l] = mc_rotated_edges_table[c.R][t.tri[n][l]];
+				const iType a = mc_edges[tri[l]][0], b = mc_edges[tri[l]][1];
+				const iType s = (i >> a) & 1 ? 1 : -1;
+				for (iType x = 0; x < 3; ++x) {
+					p[l][x] = mc_corners[a][x] + mc_corners[b][x];
+					d[x] += s * (mc_corners[b][x] - mc_corners[a][x]);
+				}
+			}
+			const std::array<iType, 3> u{ p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+			const std::array<iType, 3> w{ p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+			const iType dot = (u[1] * w[2] - u[2] * w[1]) * d[0] + (u[2] * w[0] - u[0] * w[2]) * d[1] + (u[0] * w[1] - u[1] * w[0]) * d[2];
+			table[i].tri[n] = dot < 0 ? std::array<iType, 3>{ tri[0], tri[2], tri[1] } : tri;
+		}
+	}
+	return table;
+}
+
+constexpr std::array<MCTriangles, 256> mc_triangle_table = get_mc_triangle_table();
+
+//volume, area, first moments moment[a] = integral of x_a, and second moments
+//second_moment[a][b] = integral of x_a x_b of the inside of a cell in cell coordinates [0, 1]^3,
+//or of a whole grid in grid coordinates (node (i, j, k) at (i, j, k))
+template<typename T = fType>
+struct MCMeasures
+{
+	T vol = T(0.0);
+	T area = T(0.0);
+	std::array<T, 3> moment{};
+	std::array<std::array<T, 3>, 3> second_moment{};
+
+	MCMeasures& operator+=(const MCMeasures& m)
+	{
+		vol += m.vol;
+		area += m.area;
+		for (iType a = 0; a < 3; ++a) {
+			moment[a] += m.moment[a];
+			for (iType b = 0; b < 3; ++b) second_moment[a][b] += m.second_moment[a][b];
+		}
+		return *this;
+	}
+
+	friend MCMeasures operator+(MCMeasures l, const MCMeasures& r) { return l += r; }
+};
+
+//coordinate c + d f of a point at the fraction f of an edge (d = -1, 0, or 1)
+template<iType c, iType d, typename T>
+constexpr T get_mc_edge_coord(const T f)
+{
+	if constexpr (d == 0) return T(c);
+	else if constexpr (d > 0) return T(c) + f;
+	else return T(c) - f;
+}
+
+//vertex l of surface triangle n of table index I
+template<iType I, iType n, iType l, typename T>
+constexpr std::array<T, 3> get_mc_surface_point(const std::array<T, 12>& e)
+{
+	constexpr iType k = mc_triangle_table[I].tri[n][l];
+	constexpr iType a = (I >> mc_edges[k][0]) & 1 ? mc_edges[k][0] : mc_edges[k][1];//inside corner
+	constexpr iType b = mc_edges[k][0] + mc_edges[k][1] - a;
+	return { get_mc_edge_coord<mc_corners[a][0], mc_corners[b][0] - mc_corners[a][0]>(e[k]),
+		get_mc_edge_coord<mc_corners[a][1], mc_corners[b][1] - mc_corners[a][1]>(e[k]),
+		get_mc_edge_coord<mc_corners[a][2], mc_corners[b][2] - mc_corners[a][2]>(e[k]) };
+}
+
+//area and surface integrals s1, s2, s3 of the triangle p0 p1 p2 (see get_mc_measures).
+//the polynomials are integrated in closed form from the power sums of the vertex coordinates:
+//E[x] = S1 / 3, E[x^2] = (S1^2 + S2) / 12, E[x^3] = (S1^3 + 3 S1 S2 + 2 S3) / 60,
+//E[xy] = (S1 Y1 + P) / 12, and E[x^2 y] = (S1^2 Y1 + S2 Y1 + 2 S1 P + 2 Q) / 60 are the means over the triangle,
+//where S_r = sum of x_i^r, Y1 = sum of y_i, P = sum of x_i y_i, and Q = sum of x_i^2 y_i
+template<typename T>
+inline void add_mc_triangle_measures(const std::array<T, 3>& p0, const std::array<T, 3>& p1, const std::array<T, 3>& p2,
+	T& area, std::array<T, 3>& s1, std::array<T, 3>& s2, std::array<T, 3>& s3)
+{
+	const std::array<T, 3> u{ p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+	const std::array<T, 3> v{ p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+	const std::array<T, 3> normal{ u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+	area += T(0.5) * std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+	const std::array<T, 3> sum1{ p0[0] + p1[0] + p2[0], p0[1] + p1[1] + p2[1], p0[2] + p1[2] + p2[2] };
+	for (iType x = 0; x < 3; ++x) {
+		const iType y = x == 2 ? 0 : x + 1;
+		const T x0 = p0[x], x1 = p1[x], x2 = p2[x];
+		const T xx0 = x0 * x0, xx1 = x1 * x1, xx2 = x2 * x2;
+		const T S1 = sum1[x], Y1 = sum1[y];
+		const T S2 = xx0 + xx1 + xx2;
+		const T S3 = xx0 * x0 + xx1 * x1 + xx2 * x2;
+		const T P = x0 * p0[y] + x1 * p1[y] + x2 * p2[y];
+		const T Q = xx0 * p0[y] + xx1 * p1[y] + xx2 * p2[y];
+		const T ex = S1 / T(3.0), ex2 = (S1 * S1 + S2) / T(12.0), ex3 = (S1 * S1 * S1 + T(3.0) * S1 * S2 + T(2.0) * S3) / T(60.0);
+		const T exy = (S1 * Y1 + P) / T(12.0), ex2y = (S1 * S1 * Y1 + S2 * Y1 + T(2.0) * (S1 * P + Q)) / T(60.0);
+		s1[x] += normal[x] * (ex2 - ex);
+		s2[x] += normal[x] * (ex3 / T(3.0) - ex2 / T(2.0) + ex / T(6.0));
+		s3[x] += normal[x] * (ex2y - exy);
+	}
+}
+
+//the surface triangles of table index I, unrolled at compile time
+template<iType I, typename T, iType... n>
+inline void add_mc_surface_measures(const std::array<T, 12>& e, T& area, std::array<T, 3>& s1, std::array<T, 3>& s2, std::array<T, 3>& s3,
+	std::integer_sequence<iType, n...>)
+{
+	(add_mc_triangle_measures(get_mc_surface_point<I, n, 0>(e), get_mc_surface_point<I, n, 1>(e), get_mc_surface_point<I, n, 2>(e),
+		area, s1, s2, s3), ...);
+}
+
+//the moments are integrated over the surface triangles only: with the fields
+//((x^2 - x) / 2, 0, 0), ((x^3 / 3 - x^2 / 2 + x / 6), 0, 0), and ((x^2 - x) / 2 y, 0, 0),
+//which vanish on the cell faces, the divergence theorem gives
+//integral of x = S + vol / 2, of x^2 = S + integral of x - vol / 6, and of xy = S + integral of y / 2,
+//where S is the flux through the surface, i.e., the sum of E[field] normal[x] / 2 over the triangles.
+//vol is that of get_mc_vol, and area is that of get_mc_area up to rounding
+template<typename B = MCBackend, typename T = fType>
+MCMeasures<T> get_mc_measures(const iType table_index, const std::array<T, 12>& e)
+{
+	MCMeasures<T> m;
+	if (table_index == 0) return m;
+	m.vol = table_index == 255 ? T(1.0) : get_mc_vol<B>(table_index, e);
+
+	std::array<T, 3> s1{}, s2{}, s3{};
+	visit_mc_table_index(table_index, [&](auto I) {
+		add_mc_surface_measures<decltype(I)::value>(e, m.area, s1, s2, s3,
+			std::make_integer_sequence<iType, mc_triangle_table[decltype(I)::value].num>());
+	});
+	for (iType a = 0; a < 3; ++a) m.moment[a] = T(0.25) * s1[a] + T(0.5) * m.vol;
+	for (iType a = 0; a < 3; ++a) {
+		const iType b = a == 2 ? 0 : a + 1;
+		m.second_moment[a][a] = T(0.5) * s2[a] + m.moment[a] - m.vol / T(6.0);
+		m.second_moment[a][b] = m.second_moment[b][a] = T(0.25) * s3[a] + T(0.5) * m.moment[b];
+	}
+	return m;
+}
+
+//the table index and the edge fractions are computed once and shared by all measures
+template<typename B = MCBackend, typename T = fType>
+MCMeasures<T> get_mc_measures(const std::array<T, 8>& v)
+{
+	std::array<T, 12> e;
+	for (iType k = 0; k < 12; ++k) e[k] = get_len_frac(v[mc_edges[k][0]], v[mc_edges[k][1]]);
+	return get_mc_measures<B>(get_mc_table_index(v), e);
+}
+
+//adds the measures m of the cell whose corner 0 is at o
+template<typename A, typename T>
+void add_mc_measures(MCMeasures<A>& sum, const MCMeasures<T>& m, const std::array<A, 3>& o)
+{
+	sum.vol += A(m.vol);
+	sum.area += A(m.area);
+	for (iType a = 0; a < 3; ++a) sum.moment[a] += A(m.moment[a]) + o[a] * A(m.vol);
+	for (iType a = 0; a < 3; ++a) {
+		for (iType b = 0; b < 3; ++b) {
+			sum.second_moment[a][b] += A(m.second_moment[a][b]) + o[a] * A(m.moment[b]) + o[b] * A(m.moment[a]) + o[a] * o[b] * A(m.vol);
+		}
+	}
+}
+
+template<typename T>
+std::array<T, 3> get_mc_centroid(const MCMeasures<T>& m)
+{
+	return { m.moment[0] / m.vol, m.moment[1] / m.vol, m.moment[2] / m.vol };
+}
+
+//inertia tensor of the inside (unit density) about its centroid
+template<typename T>
+std::array<std::array<T, 3>, 3> get_mc_inertia(const MCMeasures<T>& m)
+{
+	const std::array<T, 3> c = get_mc_centroid(m);
+	std::array<std::array<T, 3>, 3> s;
+	for (iType a = 0; a < 3; ++a)
+		for (iType b = 0; b < 3; ++b) s[a][b] = m.second_moment[a][b] - m.vol * c[a] * c[b];
+	const T trace = s[0][0] + s[1][1] + s[2][2];
+	std::array<std::array<T, 3>, 3> inertia;
+	for (iType a = 0; a < 3; ++a)
+		for (iType b = 0; b < 3; ++b) inertia[a][b] = (a == b ? trace : T(0.0)) - s[a][b];
+	return inertia;
+}
+
+//=================================================================================================
+//		pieces
+//=================================================================================================
+
+//the inside of a cell split into its connected pieces. two inside corners are in the same piece if they
+//are joined by an edge of the cell or by a surface triangle: the inside ends of the three edges of a triangle
+//bound the same piece, which joins corners across an ambiguous face or through the cell as the case decides.
+//corners[p] is the bit mask of the corners of piece p, and piece 0 has the most corners.
+//every other piece has no corner on the face x_a = side with face[p] = 2 a + side.
+//edge_joined is false if the triangles join corners that the edges of the cell do not
+struct MCPieces
+{
+	iType num;
+	bool edge_joined;
+	std::array<iType, 4> corners;
+	std::array<iType, 4> face;
+	std::array<iType, 5> triangle_piece;//piece bounded by each triangle of mc_triangle_table
+};
+
+constexpr iType get_mc_corner_root(const std::array<iType, 8>& parent, iType c)
+{
+	while (parent[c] != c) c = parent[c];
+	return c;
+}
+
+constexpr std::array<MCPieces, 256> get_mc_pieces_table()
+{
+	std::array<MCPieces, 256> table{};
+	for (iType i = 0; i < 256; ++i) {
+		const auto inside_corner = [i](const iType k) { return (i >> mc_edges[k][0]) & 1 ? mc_edges[k][0] : mc_edges[k][1]; };
+		const auto unite = [](std::array<iType, 8>& parent, const iType a, const iType b) {
+			const iType ra = get_mc_corner_root(parent, a), rb = get_mc_corner_root(parent, b);
+			if (ra != rb) parent[std::max(ra, rb)] = std::min(ra, rb);
+		};
+		std::array<iType, 8> edge_parent{}, parent{};
+		for (iType c = 0; c < 8; ++c) edge_parent[c] = c;
+		for (const std::array<iType, 2>& edge : mc_edges) {
+			if ((i >> edge[0]) & 1 && (i >> edge[1]) & 1) unite(edge_parent, edge[0], edge[1]);
+		}
+		parent = edge_parent;
+		const MCTriangles& t = mc_triangle_table[i];
+		for (iType n = 0; n < t.num; ++n) {
+			unite(parent, inside_corner(t.tri[n][0]), inside_corner(t.tri[n][1]));
+			unite(parent, inside_corner(t.tri[n][0]), inside_corner(t.tri[n][2]));
+		}
+
+		MCPieces& p = table[i];
+		p.edge_joined = true;
+		for (iType c = 0; c < 8; ++c) {
+			if (!((i >> c) & 1)) continue;
+			const iType r = get_mc_corner_root(parent, c);
+			if (get_mc_corner_root(edge_parent, c) != get_mc_corner_root(edge_parent, r)) p.edge_joined = false;
+			if (r == c) p.corners[p.num++] = 1 << c;
+			else for (iType q = 0; q < p.num; ++q) {
+				if ((p.corners[q] >> r) & 1) p.corners[q] |= 1 << c;
+			}
+		}
+		const auto count = [](iType mask) {
+			iType num = 0;
+			for (; mask; mask >>= 1) num += mask & 1;
+			return num;
+		};
+		for (iType q = 1; q < p.num; ++q) {
+			if (count(p.corners[q]) > count(p.corners[0])) {
+				const iType c = p.corners[q];
+				p.corners[q] = p.corners[0];
+				p.corners[0] = c;
+			}
+		}
+		for (iType q = 0; q < p.num; ++q) {
+			p.face[q] = -1;
+			for (iType f = 5; f >= 0; --f) {
+				bool touches = false;
+				for (iType c = 0; c < 8; ++c) {
+					if ((p.corners[q] >> c) & 1 && mc_corners[c][f / 2] == f % 2) touches = true;
+				}
+				if (!touches) p.face[q] = f;
+			}
+		}
+		for (iType n = 0; n < t.num; ++n) {
+			for (iType q = 0; q < p.num; ++q) {
+				if ((p.corners[q] >> inside_corner(t.tri[n][0])) & 1) p.triangle_piece[n] = q;
+			}
+		}
+	}
+	return table;
+}
+
+constexpr std::array<MCPieces, 256> mc_pieces_table = get_mc_pieces_table();
+
+constexpr bool is_mc_pieces_table_valid()
+{
+	for (const MCPieces& p : mc_pieces_table) {
+		if (!p.edge_joined) return false;
+		for (iType q = 1; q < p.num; ++q) {
+			if (p.face[q] < 0) return false;
+		}
+	}
+	return true;
+}
+
+//the cases separate the corners at every ambiguous face and inside the cell, so the pieces are
+//the corners connected by cell edges, and the inside regions of a grid are those connected by grid edges
+static_assert(is_mc_pieces_table_valid(), "a piece is joined through a face or the cell, or a piece other than the largest one touches all faces");
+
+//volume and area of each piece of a cell with table index table_index (see MCPieces).
+//the area of a piece is that of its triangles. the volume of a piece p > 0 with the free face x_a = side
+//is the flux of the field (x_a - 1 + side) e_a through its triangles: the field vanishes on the opposite face,
+//and the piece does not reach the free face, so the other cell faces add nothing.
+//piece 0 gets the rest of get_mc_vol, so the volumes add up to get_mc_vol
+template<typename B = MCBackend, typename T = fType>
+void get_mc_piece_measures(const iType table_index, const std::array<T, 12>& e, std::array<T, 4>& vol, std::array<T, 4>& area)
+{
+	const MCPieces& p = mc_pieces_table[table_index];
+	const MCTriangles& t = mc_triangle_table[table_index];
+	vol.fill(T(0.0));
+	area.fill(T(0.0));
+	if (p.num == 0) return;
+
+	for (iType n = 0; n < t.num; ++n) {
+		std::array<std::array<T, 3>, 3> x;
+		for (iType l = 0; l < 3; ++l) {
+			const iType k = t.tri[n][l];
+			const iType a = (table_index >> mc_edges[k][0]) & 1 ? mc_edges[k][0] : mc_edges[k][1];
+			const iType b = mc_edges[k][0] + mc_edges[k][1] - a;
+			for (iType d = 0; d < 3; ++d) x[l][d] = T(mc_corners[a][d]) + T(mc_corners[b][d] - mc_corners[a][d]) * e[k];
+		}
+		const std::array<T, 3> u{ x[1][0] - x[0][0], x[1][1] - x[0][1], x[1][2] - x[0][2] };
+		const std::array<T, 3> w{ x[2][0] - x[0][0], x[2][1] - x[0][1], x[2][2] - x[0][2] };
+		const std::array<T, 3> normal{ u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0] };
+		const iType q = p.triangle_piece[n];
+		area[q] += T(0.5) * std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (q == 0) continue;
+		const iType a = p.face[q] / 2, side = p.face[q] % 2;
+		vol[q] += T(0.5) * normal[a] * ((x[0][a] + x[1][a] + x[2][a]) / T(3.0) - T(1 - side));
 	}
+	vol[0] = table_index == 255 ? T(1.0) : get_mc_vol<B>(table_index, e);
+	for (iType q = 1; q < p.num; ++q) vol[0] -= vol[q];
 }
 
 //=================================================================================================
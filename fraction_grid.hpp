@@ -0,0 +1,1421 @@
+/*
+Copyright(c) 2021, Tetsuya Takahashi and Christopher Batty
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this softwareand associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright noticeand this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FRACTION_GRID_HPP
+#define FRACTION_GRID_HPP
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "fraction.hpp"
+
+namespace Fraction
+{
+
+//=================================================================================================
+//		mc-style grid
+//=================================================================================================
+
+//phi is a dense nx * ny * nz array of node values stored as phi[i + nx * (j + ny * k)].
+//cell (i, j, k) has the corners (i,j,k), (i+1,j,k), (i+1,j+1,k), (i,j+1,k),
+//(i,j,k+1), (i+1,j,k+1), (i+1,j+1,k+1), (i,j+1,k+1), i.e., the same order as S8.
+//the node type T (float or double) is deduced from phi and the kernels run in T;
+//the reductions accumulate in A, which defaults to T, e.g., get_mc_vol_grid<float, double>(phi, ...)
+
+//box of cells [i0, i1) x [j0, j1) x [k0, k1)
+struct MCBox
+{
+	iType i0, j0, k0, i1, j1, k1;
+};
+
+//sign bits and edge fractions of one z-slice of sx * sy nodes, indexed by i + sx * j.
+//edges whose end points have the same sign are fully inside (1) or outside (0),
+//so the fraction is only computed for edges crossing the surface
+template<typename T>
+struct MCSlice
+{
+	std::vector<std::uint8_t> sign;//1 if inside
+	std::vector<std::uint8_t> quad;//ms-style table index of the quad (i, j)
+	std::vector<T> ex;//edge (i, j)-(i+1, j)
+	std::vector<T> ey;//edge (i, j)-(i, j+1)
+
+	//p points to node (0, 0) of the slice, and rows of the slice are nx apart in p
+	void load(const T* p, const iType nx, const iType sx, const iType sy)
+	{
+		const std::size_t n = std::size_t(sx) * sy;
+		sign.resize(n);
+		quad.resize(n);
+		ex.resize(n);
+		ey.resize(n);
+		const auto set_frac = [p, nx, sx](std::vector<T>& e, const iType i, const iType j, const iType di, const iType dj) {
+			e[std::size_t(sx) * j + i] = get_len_frac(p[std::size_t(nx) * j + i], p[std::size_t(nx) * (j + dj) + i + di]);
+		};
+		for (iType j = 0; j < sy; ++j) {
+			const std::size_t r = std::size_t(sx) * j;
+			const T* row = p + std::size_t(nx) * j;
+			for (iType i = 0; i < sx; ++i) {
+				sign[r + i] = row[i] < iso_value;
+				ex[r + i] = ey[r + i] = T(sign[r + i]);
+			}
+			if (j == 0) continue;
+
+			//quads of the previous row; an edge crossing the surface is shared only by mixed quads,
+			//so each mixed quad computes its bottom and left edges (and its top/right ones on the boundary)
+			const std::size_t r0 = r - sx;
+			for (iType i = 0; i + 1 < sx; ++i) {
+				const iType q = sign[r0 + i] | (sign[r0 + i + 1] << 1) | (sign[r + i + 1] << 2) | (sign[r + i] << 3);
+				quad[r0 + i] = std::uint8_t(q);
+				if (q == 0 || q == 15) continue;
+				if ((q ^ (q >> 1)) & 1) set_frac(ex, i, j - 1, 1, 0);
+				if ((q ^ (q >> 3)) & 1) set_frac(ey, i, j - 1, 0, 1);
+				if (i + 2 == sx && ((q >> 1) ^ (q >> 2)) & 1) set_frac(ey, i + 1, j - 1, 0, 1);
+				if (j + 1 == sy && ((q >> 2) ^ (q >> 3)) & 1) set_frac(ex, i, j, 1, 0);
+			}
+		}
+	}
+};
+
+//walks the cells of a box slice by slice with a rolling buffer of two slices,
+//so each node is classified once and each edge fraction is computed once.
+//begin() takes the slice box.k0 and step(k, ...) the slice k + 1, each as a pointer to node (box.i0, box.j0, k)
+//with rows nx apart; the slice k has to stay valid until step(k, ...) returns
+template<typename T>
+struct MCWalker
+{
+	iType nx = 0, sx = 0, sy = 0;
+	MCBox box{};
+	std::vector<T> ez;//edge (i, j, k)-(i, j, k+1)
+	MCSlice<T> slices[2];
+	const T* p = nullptr;//slice k
+
+	//false if the box has no cells
+	bool begin(const T* p0, const iType nx_, const MCBox& box_)
+	{
+		nx = nx_;
+		box = box_;
+		sx = box.i1 - box.i0 + 1;
+		sy = box.j1 - box.j0 + 1;
+		if (sx < 2 || sy < 2 || box.k1 <= box.k0) return false;
+		ez.resize(std::size_t(sx) * sy);
+		p = p0;
+		slices[0].load(p, nx, sx, sy);
+		return true;
+	}
+
+	//calls f(i, j, k, table_index, e) for every cell of the layer k, where e is the S12 of the cell
+	template<typename F>
+	void step(const iType k, const T* p1, F&& f)
+	{
+		const std::array<T, 12> outside{};
+		std::array<T, 12> inside;
+		inside.fill(T(1.0));
+
+		const T* p0 = p;
+		p = p1;
+		const MCSlice<T>& lo = slices[(k - box.k0) & 1];
+		MCSlice<T>& hi = slices[(k - box.k0 + 1) & 1];
+		hi.load(p1, nx, sx, sy);
+		for (iType j = 0; j < sy; ++j) {
+			for (iType i = 0; i < sx; ++i) {
+				const std::size_t c = std::size_t(sx) * j + i, n = std::size_t(nx) * j + i;
+				ez[c] = lo.sign[c] != hi.sign[c] ? get_len_frac(p0[n], p1[n]) : T(lo.sign[c]);
+			}
+		}
+
+		for (iType j = 0; j + 1 < sy; ++j) {
+			for (iType i = 0; i + 1 < sx; ++i) {
+				const std::size_t c = std::size_t(sx) * j + i;
+				const iType table_index = lo.quad[c] | (hi.quad[c] << 4);
+				if (table_index == 0) { f(box.i0 + i, box.j0 + j, k, table_index, outside); continue; }
+				if (table_index == 255) { f(box.i0 + i, box.j0 + j, k, table_index, inside); continue; }
+				const std::array<T, 12> e{
+					lo.ex[c], lo.ey[c + 1], lo.ex[c + sx], lo.ey[c],
+					hi.ex[c], hi.ey[c + 1], hi.ex[c + sx], hi.ey[c],
+					ez[c], ez[c + 1], ez[c + 1 + sx], ez[c + sx] };
+				f(box.i0 + i, box.j0 + j, k, table_index, e);
+			}
+		}
+	}
+};
+
+//calls f(i, j, k, table_index, e) for every cell in the box, where e is the S12 of the cell.
+//get_slice(k) returns a pointer to node (box.i0, box.j0, k) with rows nx apart; it is called
+//for k = box.k0, ..., box.k1 in this order, and the slice k has to stay valid until slice k + 1 is returned
+template<typename T, typename G, typename F>
+void for_each_mc_cell_slices(G&& get_slice, const iType nx, const MCBox& box, F&& f)
+{
+	MCWalker<T> walker;
+	if (box.i1 - box.i0 < 1 || box.j1 - box.j0 < 1 || box.k1 <= box.k0) return;
+	walker.begin(get_slice(box.k0), nx, box);
+	for (iType k = box.k0; k < box.k1; ++k) walker.step(k, get_slice(k + 1), f);
+}
+
+template<typename T, typename F>
+void for_each_mc_cell(const T* phi, const iType nx, const iType ny, const MCBox& box, F&& f)
+{
+	const std::size_t nxy = std::size_t(nx) * ny;
+	const T* origin = phi + box.i0 + std::size_t(nx) * box.j0;
+	for_each_mc_cell_slices<T>([origin, nxy](const iType k) { return origin + nxy * k; }, nx, box, std::forward<F>(f));
+}
+
+template<typename T, typename F>
+void for_each_mc_cell(const T* phi, const iType nx, const iType ny, const iType nz, F&& f)
+{
+	for_each_mc_cell(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, std::forward<F>(f));
+}
+
+//s is the spacing of the nodes (MCUnitSpacing, MCIsoSpacing, or MCSpacing). the volume is summed in cells
+//and scaled once, and the area kernels weight the triangle normals with the spacing of each axis
+template<typename T, typename A = T, typename S = MCUnitSpacing>
+A get_mc_vol_grid(const T* phi, const iType nx, const iType ny, const MCBox& box, const S& s = S())
+{
+	A vol = 0.0;
+	for_each_mc_cell(phi, nx, ny, box, [&vol](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+		if (table_index == 0) return;
+		vol += table_index == 255 ? A(1.0) : A(get_mc_vol(table_index, e));
+	});
+	if constexpr (std::is_same_v<S, MCUnitSpacing>) return vol;
+	else return A(get_mc_cell_vol<T>(s)) * vol;
+}
+
+template<typename T, typename A = T, typename S = MCUnitSpacing>
+A get_mc_area_grid(const T* phi, const iType nx, const iType ny, const MCBox& box, const S& s = S())
+{
+	A area = 0.0;
+	for_each_mc_cell(phi, nx, ny, box, [&area, &s](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+		if (table_index == 0 || table_index == 255) return;
+		area += A(get_mc_area(table_index, e, s));
+	});
+	return area;
+}
+
+//get_mc_vol_grid with get_mc_vol_approx, within mc_vol_approx_error per cell crossing the surface
+template<typename T, typename A = T>
+A get_mc_vol_grid_approx(const T* phi, const iType nx, const iType ny, const MCBox& box)
+{
+	A vol = 0.0;
+	for_each_mc_cell(phi, nx, ny, box, [&vol](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+		if (table_index == 0) return;
+		vol += table_index == 255 ? A(1.0) : A(get_mc_vol_approx(table_index, e));
+	});
+	return vol;
+}
+
+template<typename T, typename A = T, typename S = MCUnitSpacing>
+A get_mc_vol_grid(const T* phi, const iType nx, const iType ny, const iType nz, const S& s = S())
+{
+	return get_mc_vol_grid<T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, s);
+}
+
+template<typename T, typename A = T, typename S = MCUnitSpacing>
+A get_mc_area_grid(const T* phi, const iType nx, const iType ny, const iType nz, const S& s = S())
+{
+	return get_mc_area_grid<T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, s);
+}
+
+template<typename T, typename A = T>
+A get_mc_vol_grid_approx(const T* phi, const iType nx, const iType ny, const iType nz)
+{
+	return get_mc_vol_grid_approx<T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 });
+}
+
+//volume, area, and first and second moments of the inside in grid coordinates (node (i, j, k) at (i, j, k)),
+//from one walk over the cells that shares the classification and the edge fractions
+template<typename T, typename A = T>
+MCMeasures<A> get_mc_measures_grid(const T* phi, const iType nx, const iType ny, const MCBox& box)
+{
+	MCMeasures<A> sum;
+	for_each_mc_cell(phi, nx, ny, box, [&sum](const iType i, const iType j, const iType k, const iType table_index, const std::array<T, 12>& e) {
+		if (table_index == 0) return;
+		add_mc_measures(sum, get_mc_measures(table_index, e), std::array<A, 3>{ A(i), A(j), A(k) });
+	});
+	return sum;
+}
+
+template<typename T, typename A = T>
+MCMeasures<A> get_mc_measures_grid(const T* phi, const iType nx, const iType ny, const iType nz)
+{
+	return get_mc_measures_grid<T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 });
+}
+
+//=================================================================================================
+//		surface mesh
+//=================================================================================================
+
+//caller-provided buffers of a triangle mesh in grid coordinates (node (i, j, k) at (i, j, k)):
+//vertex v at vertices[3 v], vertices[3 v + 1], vertices[3 v + 2] and triangle t at triangles[3 t], ..., triangles[3 t + 2].
+//num_vertices/num_triangles count what the grid needs, also beyond the capacities,
+//and only the first max_vertices/max_triangles are written, so a call with too small buffers gives the sizes to allocate.
+//the vertex indices are of type I, whose largest value is reserved; a grid with more vertices than I can index
+//(max_index) is not complete, and a mesh of more than 2^32 - 1 vertices needs I = std::uint64_t
+template<typename T = fType, typename I = std::uint32_t>
+struct MCMesh
+{
+	static constexpr std::size_t max_index = std::numeric_limits<I>::max();
+
+	T* vertices = nullptr;
+	I* triangles = nullptr;
+	std::size_t max_vertices = 0, max_triangles = 0;
+	std::size_t num_vertices = 0, num_triangles = 0;
+
+	bool complete() const { return num_vertices <= max_vertices && num_triangles <= max_triangles && num_vertices <= max_index; }
+};
+
+//axis and lower corner of e0, ..., e11
+constexpr std::array<std::array<iType, 2>, 12> mc_edge_axes = []() {
+	std::array<std::array<iType, 2>, 12> axes{};
+	for (iType l = 0; l < 12; ++l) {
+		const iType a = mc_edges[l][0], b = mc_edges[l][1];
+		const iType axis = mc_corners[a][0] != mc_corners[b][0] ? 0 : mc_corners[a][1] != mc_corners[b][1] ? 1 : 2;
+		axes[l] = { axis, mc_corners[a][axis] < mc_corners[b][axis] ? a : b };
+	}
+	return axes;
+}();
+
+//volume and area of the cells in the box in one pass, as get_mc_vol_grid/get_mc_area_grid, and optionally the
+//triangles of mc_triangle_table that get_mc_area_case integrates, appended to mesh. each triangle is oriented from the
+//inside to the outside, and its vertices are the edge crossings of the cell (the S12 of get_e). a crossing is emitted
+//once for all cells around its grid edge: the indices of the x/y edges of two slices and of the z edges of a layer roll
+//with the walker, so the mesh of a box is closed where the surface does not leave the box. once the vertices run out
+//of indices of type I, the further crossings are counted but not written, and their triangles refer to max_index
+template<typename T, typename A = T, typename I = std::uint32_t>
+void get_mc_vol_area_grid(const T* phi, const iType nx, const iType ny, const MCBox& box, A& vol, A& area, MCMesh<T, I>* mesh = nullptr)
+{
+	vol = area = A(0.0);
+	const std::size_t sx = std::size_t(std::max(box.i1 - box.i0 + 1, 0)), sy = std::size_t(std::max(box.j1 - box.j0 + 1, 0));
+	constexpr I none = I(MCMesh<T, I>::max_index);
+	std::vector<I> ids;//x and y edges of the slices of parity 0 and 1, and z edges
+	if (mesh) ids.assign(5 * sx * sy, none);
+	iType layer = box.k0 - 1;
+
+	const auto get_vertex = [&](const iType i, const iType j, const iType k, const iType table_index, const iType l, const T f) {
+		const iType a = (table_index >> mc_edges[l][0]) & 1 ? mc_edges[l][0] : mc_edges[l][1];//inside corner
+		const iType b = mc_edges[l][0] + mc_edges[l][1] - a;
+		const iType axis = mc_edge_axes[l][0], c = mc_edge_axes[l][1];//c: lower end of the grid edge
+		const std::size_t n = std::size_t(i - box.i0 + mc_corners[c][0]) + sx * std::size_t(j - box.j0 + mc_corners[c][1]);
+		const std::size_t slot = axis == 2 ? 4 * sx * sy + n : (2 * ((k + mc_corners[c][2] - box.k0) & 1) + axis) * sx * sy + n;
+		I& id = ids[slot];
+		if (id != none) return id;
+		if (mesh->num_vertices >= MCMesh<T, I>::max_index) {
+			++mesh->num_vertices;
+			return none;
+		}
+		id = I(mesh->num_vertices++);
+		if (id < mesh->max_vertices) {
+			T* p = mesh->vertices + 3 * std::size_t(id);
+			p[0] = T(i + mc_corners[a][0]) + T(mc_corners[b][0] - mc_corners[a][0]) * f;
+			p[1] = T(j + mc_corners[a][1]) + T(mc_corners[b][1] - mc_corners[a][1]) * f;
+			p[2] = T(k + mc_corners[a][2]) + T(mc_corners[b][2] - mc_corners[a][2]) * f;
+		}
+		return id;
+	};
+
+	for_each_mc_cell(phi, nx, ny, box, [&](const iType i, const iType j, const iType k, const iType table_index, const std::array<T, 12>& e) {
+		if (mesh && k != layer) {
+			layer = k;
+			std::fill(ids.begin() + 2 * ((k + 1 - box.k0) & 1) * sx * sy, ids.begin() + (2 * ((k + 1 - box.k0) & 1) + 2) * sx * sy, none);
+			std::fill(ids.begin() + 4 * sx * sy, ids.end(), none);
+		}
+		if (table_index == 0) return;
+		if (table_index == 255) {
+			vol += A(1.0);
+			return;
+		}
+		vol += A(get_mc_vol(table_index, e));
+		area += A(get_mc_area(table_index, e));
+		if (!mesh) return;
+		const MCTriangles& t = mc_triangle_table[table_index];
+		for (iType n = 0; n < t.num; ++n) {
+			const std::size_t m = mesh->num_triangles++;
+			std::array<I, 3> tri;
+			for (iType l = 0; l < 3; ++l) tri[l] = get_vertex(i, j, k, table_index, t.tri[n][l], e[t.tri[n][l]]);
+			if (m < mesh->max_triangles) std::copy(tri.begin(), tri.end(), mesh->triangles + 3 * m);
+		}
+	});
+}
+
+template<typename T, typename A = T, typename I = std::uint32_t>
+void get_mc_vol_area_grid(const T* phi, const iType nx, const iType ny, const iType nz, A& vol, A& area, MCMesh<T, I>* mesh = nullptr)
+{
+	get_mc_vol_area_grid(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, vol, area, mesh);
+}
+
+//=================================================================================================
+//		parallel grid
+//=================================================================================================
+
+//the cells are split into fixed bricks of mc_brick_size^3 cells, each brick is summed serially,
+//and the brick sums are added in a fixed pairwise order.
+//the result therefore does not depend on the number of threads or on the scheduling,
+//but it can differ in the last bits from the serial get_mc_vol_grid/get_mc_area_grid
+constexpr iType mc_brick_size = 32;
+
+//runs task(0), ..., task(n - 1) on num_threads std::threads (0: hardware_concurrency).
+//any callable with the same signature can be used as an executor, e.g., to run on a thread pool
+struct ThreadExecutor
+{
+	iType num_threads = 0;
+
+	template<typename F>
+	void operator()(const iType n, F&& task) const
+	{
+		iType num = num_threads > 0 ? num_threads : iType(std::thread::hardware_concurrency());
+		num = std::max(1, std::min(num, n));
+		std::atomic<iType> next{ 0 };
+		const auto run = [&]() {
+			for (iType i = next++; i < n; i = next++) task(i);
+		};
+		std::vector<std::thread> threads;
+		for (iType t = 1; t < num; ++t) threads.emplace_back(run);
+		run();
+		for (std::thread& t : threads) t.join();
+	}
+};
+
+//sum of v[0], ..., v[n - 1] in a fixed pairwise order
+template<typename A>
+A get_pairwise_sum(const A* v, const std::size_t n)
+{
+	if (n == 0) return A();
+	if (n == 1) return v[0];
+	const std::size_t h = n / 2;
+	return get_pairwise_sum(v, h) + get_pairwise_sum(v + h, n - h);
+}
+
+inline iType get_mc_brick_count(const iType n)
+{
+	return (n - 1 + mc_brick_size - 1) / mc_brick_size;
+}
+
+inline MCBox get_mc_brick(const iType nx, const iType ny, const iType nz, const iType b)
+{
+	const iType bx = get_mc_brick_count(nx), by = get_mc_brick_count(ny);
+	const iType i0 = (b % bx) * mc_brick_size, j0 = (b / bx % by) * mc_brick_size, k0 = (b / bx / by) * mc_brick_size;
+	return { i0, j0, k0,
+		std::min(i0 + mc_brick_size, nx - 1), std::min(j0 + mc_brick_size, ny - 1), std::min(k0 + mc_brick_size, nz - 1) };
+}
+
+//sums g(box) over all bricks of the grid
+template<typename A, typename G, typename Executor>
+A reduce_mc_bricks(const iType nx, const iType ny, const iType nz, G&& g, const Executor& exec)
+{
+	if (nx < 2 || ny < 2 || nz < 2) return A();
+	const iType num_bricks = get_mc_brick_count(nx) * get_mc_brick_count(ny) * get_mc_brick_count(nz);
+	std::vector<A> partial(num_bricks);
+	exec(num_bricks, [&](const iType b) { partial[b] = g(get_mc_brick(nx, ny, nz, b)); });
+	return get_pairwise_sum(partial.data(), partial.size());
+}
+
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+A get_mc_vol_grid_parallel(const T* phi, const iType nx, const iType ny, const iType nz, const Executor& exec = Executor())
+{
+	return reduce_mc_bricks<A>(nx, ny, nz, [&](const MCBox& box) { return get_mc_vol_grid<T, A>(phi, nx, ny, box); }, exec);
+}
+
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+A get_mc_area_grid_parallel(const T* phi, const iType nx, const iType ny, const iType nz, const Executor& exec = Executor())
+{
+	return reduce_mc_bricks<A>(nx, ny, nz, [&](const MCBox& box) { return get_mc_area_grid<T, A>(phi, nx, ny, box); }, exec);
+}
+
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+MCMeasures<A> get_mc_measures_grid_parallel(const T* phi, const iType nx, const iType ny, const iType nz, const Executor& exec = Executor())
+{
+	return reduce_mc_bricks<MCMeasures<A>>(nx, ny, nz, [&](const MCBox& box) { return get_mc_measures_grid<T, A>(phi, nx, ny, box); }, exec);
+}
+
+//=================================================================================================
+//		fraction fields
+//=================================================================================================
+
+//the faces of a cell normal to x, y, and z on its lower and upper side (face 2 a + side), as ms-style quads:
+//the corners in the order of the quad, and the edges of the cell between corners 0-1, 1-2, 2-3, and 3-0 of the quad
+struct MCFace
+{
+	std::array<iType, 4> corners;
+	std::array<iType, 4> edges;
+};
+
+constexpr std::array<MCFace, 6> mc_faces{ {
+	{ { 0, 3, 7, 4 }, { 3, 11, 7, 8 } }, { { 1, 2, 6, 5 }, { 1, 10, 5, 9 } },
+	{ { 0, 1, 5, 4 }, { 0, 9, 4, 8 } }, { { 3, 2, 6, 7 }, { 2, 10, 6, 11 } },
+	{ { 0, 1, 2, 3 }, { 0, 1, 2, 3 } }, { { 4, 5, 6, 7 }, { 4, 5, 6, 7 } } } };
+
+//ms-style table index of each face of each table index
+constexpr std::array<std::array<std::uint8_t, 6>, 256> mc_face_quads = []() {
+	std::array<std::array<std::uint8_t, 6>, 256> quads{};
+	for (iType table_index = 0; table_index < 256; ++table_index) {
+		for (iType f = 0; f < 6; ++f) {
+			iType quad = 0;
+			for (iType q = 0; q < 4; ++q) quad |= ((table_index >> mc_faces[f].corners[q]) & 1) << q;
+			quads[table_index][f] = std::uint8_t(quad);
+		}
+	}
+	return quads;
+}();
+
+//per-cell volume fractions vol[i + (nx - 1) * (j + (ny - 1) * k)] (get_mc_vol of cell (i, j, k)) and
+//face area fractions (get_ms_area of the face) of the faces normal to x, y, and z, stored as in a MAC grid:
+//fx[i + nx * (j + (ny - 1) * k)] of the face at node i spanning the cells (j, k),
+//fy[i + (nx - 1) * (j + ny * k)], and fz[i + (nx - 1) * (j + (ny - 1) * k)].
+//the grid is split into the bricks of get_mc_vol_grid_parallel; each brick writes its cells and the faces
+//on its lower sides (and its upper sides on the grid boundary), so each face is evaluated once
+//and the bricks can run in parallel. the cells and faces are evaluated in one walk: the faces take the
+//corner signs and edge fractions of the cell from the walker, and the corner values are read only for the
+//split of the ambiguous faces. null buffers are skipped
+template<typename T>
+void get_mc_fraction_fields(const T* phi, const iType nx, const iType ny, const MCBox& box, T* vol, T* fx, T* fy, T* fz,
+	const bool last_i, const bool last_j, const bool last_k)
+{
+	if (!vol && !fx && !fy && !fz) return;
+	const std::size_t mx = std::size_t(nx) - 1, my = std::size_t(ny) - 1, nxy = std::size_t(nx) * ny;
+	//the last cell along each axis that writes its upper face, or -1
+	const iType ui = last_i ? box.i1 - 1 : -1, uj = last_j ? box.j1 - 1 : -1, uk = last_k ? box.k1 - 1 : -1;
+	for_each_mc_cell(phi, nx, ny, box, [&](const iType i, const iType j, const iType k, const iType table_index, const std::array<T, 12>& e) {
+		//cell (i, j, k) and its lower faces; the upper faces are 1, mx, and mx * my further
+		const std::size_t c = i + mx * (j + my * k), x = i + nx * (j + my * k), y = i + mx * (j + ny * k);
+		const bool upper_i = i == ui, upper_j = j == uj, upper_k = k == uk;
+		if (table_index == 0 || table_index == 255) {
+			const T full = T(table_index == 255);
+			if (vol) vol[c] = full;
+			if (fx) {
+				fx[x] = full;
+				if (upper_i) fx[x + 1] = full;
+			}
+			if (fy) {
+				fy[y] = full;
+				if (upper_j) fy[y + mx] = full;
+			}
+			if (fz) {
+				fz[c] = full;
+				if (upper_k) fz[c + mx * my] = full;
+			}
+			return;
+		}
+		const auto get_face = [&](const iType f) {
+			const MCFace& face = mc_faces[f];
+			const iType quad = mc_face_quads[table_index][f];
+			bool negative = false;
+			if (quad == 5 || quad == 10) {
+				T sum = T(0.0);
+				for (const iType corner : face.corners)
+					sum += phi[i + mc_corners[corner][0] + nx * (j + mc_corners[corner][1]) + nxy * (k + mc_corners[corner][2])];
+				negative = sum < 0;
+			}
+			return get_ms_area(quad, std::array<T, 4>{ e[face.edges[0]], e[face.edges[1]], e[face.edges[2]], e[face.edges[3]] }, negative);
+		};
+		if (vol) vol[c] = get_mc_vol(table_index, e);
+		if (fx) {
+			fx[x] = get_face(0);
+			if (upper_i) fx[x + 1] = get_face(1);
+		}
+		if (fy) {
+			fy[y] = get_face(2);
+			if (upper_j) fy[y + mx] = get_face(3);
+		}
+		if (fz) {
+			fz[c] = get_face(4);
+			if (upper_k) fz[c + mx * my] = get_face(5);
+		}
+	});
+}
+
+template<typename T, typename Executor = ThreadExecutor>
+void get_mc_fraction_fields(const T* phi, const iType nx, const iType ny, const iType nz, T* vol, T* fx, T* fy, T* fz,
+	const Executor& exec = Executor())
+{
+	if (nx < 2 || ny < 2 || nz < 2) return;
+	const iType num_bricks = get_mc_brick_count(nx) * get_mc_brick_count(ny) * get_mc_brick_count(nz);
+	exec(num_bricks, [&](const iType b) {
+		const MCBox box = get_mc_brick(nx, ny, nz, b);
+		get_mc_fraction_fields(phi, nx, ny, box, vol, fx, fy, fz, box.i1 == nx - 1, box.j1 == ny - 1, box.k1 == nz - 1);
+	});
+}
+
+//=================================================================================================
+//		multi-field grid
+//=================================================================================================
+
+//K fields on the same grid, e.g., one level set per material. node n (= i + nx * (j + ny * k)) of field f
+//is phi[f][stride * n]: stride 1 for separate arrays (SoA), and stride K with phi[f] = base + f for
+//interleaved fields (see get_mc_interleaved_fields)
+template<typename T>
+struct MCFields
+{
+	std::vector<const T*> phi;
+	iType stride = 1;
+};
+
+//fields stored as base[f + num * n]
+template<typename T>
+MCFields<T> get_mc_interleaved_fields(const T* base, const iType num)
+{
+	MCFields<T> fields{ std::vector<const T*>(num), num };
+	for (iType f = 0; f < num; ++f) fields.phi[f] = base + f;
+	return fields;
+}
+
+//volume vol[f] and area area[f] of every field f in the box, from one walk over the z-slices:
+//for each slice, the walkers of all fields advance before the next slice is touched, so the nodes
+//of a slice are loaded into the cache once for all fields. interleaved slices are first split into
+//one contiguous slice per field. the sums of each field equal get_mc_vol_grid/get_mc_area_grid
+template<typename T, typename A = T>
+void get_mc_grid_fields(const MCFields<T>& fields, const iType nx, const iType ny, const MCBox& box, A* vol, A* area)
+{
+	const iType num = iType(fields.phi.size());
+	for (iType f = 0; f < num; ++f) vol[f] = area[f] = A(0.0);
+	const iType sx = box.i1 - box.i0 + 1, sy = box.j1 - box.j0 + 1;
+	if (sx < 2 || sy < 2 || box.k1 <= box.k0) return;
+	const std::size_t sxy = std::size_t(sx) * sy;
+	const std::size_t nxy = std::size_t(nx) * ny;
+
+	//buffer[k & 1] holds slice k of field f at f * sxy
+	std::vector<T> buffers[2];
+	if (fields.stride > 1) for (std::vector<T>& b : buffers) b.resize(sxy * num);
+	const auto get_slices = [&](const iType k) {
+		if (fields.stride == 1) return;
+		const std::size_t origin = box.i0 + std::size_t(nx) * box.j0 + nxy * k;
+		T* b = buffers[k & 1].data();
+		const T* base = fields.phi[0] + std::size_t(fields.stride) * origin;
+		for (iType j = 0; j < sy; ++j) {
+			for (iType i = 0; i < sx; ++i) {
+				const T* node = base + std::size_t(fields.stride) * (std::size_t(nx) * j + i);
+				const std::size_t c = std::size_t(sx) * j + i;
+				for (iType f = 0; f < num; ++f) b[sxy * f + c] = node[f];
+			}
+		}
+	};
+	const auto get_slice = [&](const iType f, const iType k) {
+		if (fields.stride > 1) return static_cast<const T*>(buffers[k & 1].data() + sxy * f);
+		return fields.phi[f] + box.i0 + std::size_t(nx) * box.j0 + nxy * k;
+	};
+	const iType rows = fields.stride > 1 ? sx : nx;
+
+	std::vector<MCWalker<T>> walkers(num);
+	get_slices(box.k0);
+	for (iType f = 0; f < num; ++f) walkers[f].begin(get_slice(f, box.k0), rows, box);
+	for (iType k = box.k0; k < box.k1; ++k) {
+		get_slices(k + 1);
+		for (iType f = 0; f < num; ++f) {
+			A v = vol[f], a = area[f];
+			walkers[f].step(k, get_slice(f, k + 1), [&v, &a](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+				if (table_index == 0) return;
+				if (table_index == 255) { v += A(1.0); return; }
+				v += A(get_mc_vol(table_index, e));
+				a += A(get_mc_area(table_index, e));
+			});
+			vol[f] = v;
+			area[f] = a;
+		}
+	}
+}
+
+template<typename T, typename A = T>
+void get_mc_grid_fields(const MCFields<T>& fields, const iType nx, const iType ny, const iType nz, A* vol, A* area)
+{
+	get_mc_grid_fields<T, A>(fields, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, vol, area);
+}
+
+//the bricks of get_mc_vol_grid_parallel, with the brick sums of each field added in the same pairwise order,
+//so vol[f] and area[f] equal get_mc_vol_grid_parallel/get_mc_area_grid_parallel of field f
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+void get_mc_grid_fields_parallel(const MCFields<T>& fields, const iType nx, const iType ny, const iType nz, A* vol, A* area,
+	const Executor& exec = Executor())
+{
+	const iType num = iType(fields.phi.size());
+	for (iType f = 0; f < num; ++f) vol[f] = area[f] = A(0.0);
+	if (nx < 2 || ny < 2 || nz < 2) return;
+	const iType num_bricks = get_mc_brick_count(nx) * get_mc_brick_count(ny) * get_mc_brick_count(nz);
+	std::vector<A> partial_vol(std::size_t(num_bricks) * num), partial_area(partial_vol.size());//[f * num_bricks + b]
+	exec(num_bricks, [&](const iType b) {
+		std::vector<A> v(num), a(num);
+		get_mc_grid_fields<T, A>(fields, nx, ny, get_mc_brick(nx, ny, nz, b), v.data(), a.data());
+		for (iType f = 0; f < num; ++f) {
+			partial_vol[std::size_t(num_bricks) * f + b] = v[f];
+			partial_area[std::size_t(num_bricks) * f + b] = a[f];
+		}
+	});
+	for (iType f = 0; f < num; ++f) {
+		vol[f] = get_pairwise_sum(partial_vol.data() + std::size_t(num_bricks) * f, num_bricks);
+		area[f] = get_pairwise_sum(partial_area.data() + std::size_t(num_bricks) * f, num_bricks);
+	}
+}
+
+//=================================================================================================
+//		multi-iso grid
+//=================================================================================================
+
+//volume vol[n] and area area[n] of the region phi < iso[n] for num sorted iso values iso[0] <= iso[1] <= ...,
+//in one pass over the cells of the box. a cell with the corner values in [lo, hi] is fully outside for
+//iso[n] <= lo and fully inside for hi < iso[n]; it is evaluated (on its corner values minus iso[n]) only for the
+//iso values in (lo, hi], found by binary search, and the fully inside cells are counted per iso value.
+//each cell gives the same values as get_mc_vol/get_mc_area of phi - iso[n], but the sums can differ
+//in the last bits from get_mc_vol_grid of the shifted grid due to the summation order
+template<typename T, typename A = T>
+void get_mc_grid_iso(const T* phi, const iType nx, const iType ny, const MCBox& box, const T* iso, const iType num, A* vol, A* area)
+{
+	std::vector<std::int64_t> num_inside(num + 1);//cells fully inside for iso[n], n >= m, are counted in num_inside[m]
+	for (iType n = 0; n < num; ++n) vol[n] = area[n] = A(0.0);
+	const auto at = [phi, nx, ny](const iType i, const iType j, const iType k) { return phi[i + std::size_t(nx) * (j + std::size_t(ny) * k)]; };
+	for (iType k = box.k0; k < box.k1; ++k) {
+		for (iType j = box.j0; j < box.j1; ++j) {
+			for (iType i = box.i0; i < box.i1; ++i) {
+				const std::array<T, 8> v{ at(i, j, k), at(i + 1, j, k), at(i + 1, j + 1, k), at(i, j + 1, k),
+					at(i, j, k + 1), at(i + 1, j, k + 1), at(i + 1, j + 1, k + 1), at(i, j + 1, k + 1) };
+				const auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+				const iType n0 = iType(std::upper_bound(iso, iso + num, *lo) - iso);
+				const iType n1 = iType(std::upper_bound(iso + n0, iso + num, *hi) - iso);
+				++num_inside[n1];
+				for (iType n = n0; n < n1; ++n) {
+					std::array<T, 8> w;
+					for (iType c = 0; c < 8; ++c) w[c] = v[c] - iso[n];
+					const iType table_index = get_mc_table_index(w);
+					vol[n] += A(get_mc_vol(table_index, w));
+					area[n] += A(get_mc_area(table_index, w));
+				}
+			}
+		}
+	}
+	std::int64_t inside = 0;
+	for (iType n = 0; n < num; ++n) {
+		inside += num_inside[n];
+		vol[n] += A(inside);
+	}
+}
+
+template<typename T, typename A = T>
+void get_mc_grid_iso(const T* phi, const iType nx, const iType ny, const iType nz, const T* iso, const iType num, A* vol, A* area)
+{
+	get_mc_grid_iso<T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, iso, num, vol, area);
+}
+
+//the bricks of get_mc_vol_grid_parallel, with the brick sums of each iso value added in a fixed pairwise order
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+void get_mc_grid_iso_parallel(const T* phi, const iType nx, const iType ny, const iType nz, const T* iso, const iType num, A* vol, A* area,
+	const Executor& exec = Executor())
+{
+	for (iType n = 0; n < num; ++n) vol[n] = area[n] = A(0.0);
+	if (nx < 2 || ny < 2 || nz < 2) return;
+	const iType num_bricks = get_mc_brick_count(nx) * get_mc_brick_count(ny) * get_mc_brick_count(nz);
+	std::vector<A> partial_vol(std::size_t(num_bricks) * num), partial_area(partial_vol.size());//[n * num_bricks + b]
+	exec(num_bricks, [&](const iType b) {
+		std::vector<A> v(num), a(num);
+		get_mc_grid_iso<T, A>(phi, nx, ny, get_mc_brick(nx, ny, nz, b), iso, num, v.data(), a.data());
+		for (iType n = 0; n < num; ++n) {
+			partial_vol[std::size_t(num_bricks) * n + b] = v[n];
+			partial_area[std::size_t(num_bricks) * n + b] = a[n];
+		}
+	});
+	for (iType n = 0; n < num; ++n) {
+		vol[n] = get_pairwise_sum(partial_vol.data() + std::size_t(num_bricks) * n, num_bricks);
+		area[n] = get_pairwise_sum(partial_area.data() + std::size_t(num_bricks) * n, num_bricks);
+	}
+}
+
+//=================================================================================================
+//		gradient grid
+//=================================================================================================
+
+//volume (or area) of the box, with d(vol)/d(phi[n]) of every node added to grad[n], which has the size of phi.
+//only the cells crossing the surface are differentiated; the others add 1 (or 0) and no gradient
+template<bool vol, typename T, typename A = T>
+A get_mc_grad_grid(const T* phi, const iType nx, const iType ny, const MCBox& box, T* grad)
+{
+	A sum = 0.0;
+	const std::size_t nxy = std::size_t(nx) * ny;
+	const std::array<std::size_t, 8> offsets{ 0, 1, 1 + std::size_t(nx), std::size_t(nx), nxy, nxy + 1, nxy + 1 + nx, nxy + nx };
+	for (iType k = box.k0; k < box.k1; ++k) {
+		for (iType j = box.j0; j < box.j1; ++j) {
+			for (iType i = box.i0; i < box.i1; ++i) {
+				const std::size_t n = i + std::size_t(nx) * (j + std::size_t(ny) * k);
+				std::array<T, 8> v;
+				for (iType c = 0; c < 8; ++c) v[c] = phi[n + offsets[c]];
+				const iType table_index = get_mc_table_index(v);
+				if (table_index == 0) continue;
+				if (table_index == 255) {
+					if constexpr (vol) sum += A(1.0);
+					continue;
+				}
+				MCDual<T, 8> d;
+				if constexpr (vol) d = get_mc_vol_grad(v);
+				else d = get_mc_area_grad(v);
+				sum += A(d.value);
+				for (iType c = 0; c < 8; ++c) grad[n + offsets[c]] += d.grad[c];
+			}
+		}
+	}
+	return sum;
+}
+
+template<typename T, typename A = T>
+A get_mc_vol_grad_grid(const T* phi, const iType nx, const iType ny, const iType nz, T* grad)
+{
+	return get_mc_grad_grid<true, T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, grad);
+}
+
+template<typename T, typename A = T>
+A get_mc_area_grad_grid(const T* phi, const iType nx, const iType ny, const iType nz, T* grad)
+{
+	return get_mc_grad_grid<false, T, A>(phi, nx, ny, MCBox{ 0, 0, 0, nx - 1, ny - 1, nz - 1 }, grad);
+}
+
+//the bricks of get_mc_vol_grid_parallel in eight passes, one per parity of the brick coordinates (bi, bj, bk),
+//so that the bricks of a pass share no nodes and add to grad without synchronization. the gradient of a node
+//shared by bricks is added in the order of the passes, so grad and the pairwise sum of the brick totals
+//are independent of the number of threads, and equal to the serial functions up to rounding
+template<bool vol, typename T, typename A = T, typename Executor = ThreadExecutor>
+A get_mc_grad_grid_parallel(const T* phi, const iType nx, const iType ny, const iType nz, T* grad, const Executor& exec = Executor())
+{
+	if (nx < 2 || ny < 2 || nz < 2) return A();
+	const iType bx = get_mc_brick_count(nx), by = get_mc_brick_count(ny), bz = get_mc_brick_count(nz);
+	std::vector<A> partial(std::size_t(bx) * by * bz);
+	for (iType parity = 0; parity < 8; ++parity) {
+		const iType pi = parity & 1, pj = (parity >> 1) & 1, pk = parity >> 2;
+		const iType cx = (bx - pi + 1) / 2, cy = (by - pj + 1) / 2, cz = (bz - pk + 1) / 2;
+		exec(cx * cy * cz, [&](const iType n) {
+			const iType b = pi + 2 * (n % cx) + bx * (pj + 2 * (n / cx % cy) + by * (pk + 2 * (n / cx / cy)));
+			partial[b] = get_mc_grad_grid<vol, T, A>(phi, nx, ny, get_mc_brick(nx, ny, nz, b), grad);
+		});
+	}
+	return get_pairwise_sum(partial.data(), partial.size());
+}
+
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+A get_mc_vol_grad_grid_parallel(const T* phi, const iType nx, const iType ny, const iType nz, T* grad, const Executor& exec = Executor())
+{
+	return get_mc_grad_grid_parallel<true, T, A>(phi, nx, ny, nz, grad, exec);
+}
+
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+A get_mc_area_grad_grid_parallel(const T* phi, const iType nx, const iType ny, const iType nz, T* grad, const Executor& exec = Executor())
+{
+	return get_mc_grad_grid_parallel<false, T, A>(phi, nx, ny, nz, grad, exec);
+}
+
+//=================================================================================================
+//		incremental grid
+//=================================================================================================
+
+//keeps the volume and area of each brick of get_mc_vol_grid_parallel and re-evaluates only the bricks
+//marked dirty since the last query. the totals are the pairwise sums of the brick sums, and are therefore
+//bitwise identical to get_mc_vol_grid_parallel/get_mc_area_grid_parallel of the current phi.
+//phi has to match the tracker, i.e., every change of phi has to be marked before the next query
+template<typename T = fType, typename A = T>
+struct MCTracker
+{
+	iType nx = 0, ny = 0, nz = 0;
+	std::vector<A> vol, area;//sums of brick b (see get_mc_brick)
+	std::vector<std::uint8_t> dirty;
+	std::vector<iType> dirty_bricks;
+
+	MCTracker() = default;
+	MCTracker(const iType nx, const iType ny, const iType nz) { build(nx, ny, nz); }
+
+	//all bricks are dirty after building
+	void build(const iType nx_, const iType ny_, const iType nz_)
+	{
+		nx = nx_;
+		ny = ny_;
+		nz = nz_;
+		const iType num_bricks = nx < 2 || ny < 2 || nz < 2 ? 0 : get_mc_brick_count(nx) * get_mc_brick_count(ny) * get_mc_brick_count(nz);
+		vol.assign(num_bricks, A(0.0));
+		area.assign(num_bricks, A(0.0));
+		dirty.assign(num_bricks, 0);
+		dirty_bricks.clear();
+		mark(MCBox{ 0, 0, 0, nx, ny, nz });
+	}
+
+	//marks the bricks containing the nodes [i0, i1) x [j0, j1) x [k0, k1) after phi has changed there
+	void mark(const MCBox& nodes)
+	{
+		if (vol.empty() || nodes.i1 <= nodes.i0 || nodes.j1 <= nodes.j0 || nodes.k1 <= nodes.k0) return;
+		//node i is shared by the cells i - 1 and i
+		const auto first = [](const iType i) { return std::max(i - 1, 0) / mc_brick_size; };
+		const auto last = [](const iType i, const iType n) { return (std::min(i, n - 1) - 1) / mc_brick_size; };
+		const iType bx = get_mc_brick_count(nx), by = get_mc_brick_count(ny);
+		for (iType bk = first(nodes.k0); bk <= last(nodes.k1, nz); ++bk)
+			for (iType bj = first(nodes.j0); bj <= last(nodes.j1, ny); ++bj)
+				for (iType bi = first(nodes.i0); bi <= last(nodes.i1, nx); ++bi) mark_brick(bi + bx * (bj + by * bk));
+	}
+
+	//marks the bricks containing node (i, j, k)
+	void mark(const iType i, const iType j, const iType k)
+	{
+		mark(MCBox{ i, j, k, i + 1, j + 1, k + 1 });
+	}
+
+	//re-evaluates the dirty bricks, each with one walk over its cells for both the volume and the area
+	template<typename Executor = ThreadExecutor>
+	void update(const T* phi, const Executor& exec = Executor())
+	{
+		exec(iType(dirty_bricks.size()), [&](const iType n) {
+			const iType b = dirty_bricks[n];
+			A v = 0.0, a = 0.0;
+			for_each_mc_cell(phi, nx, ny, get_mc_brick(nx, ny, nz, b), [&](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+				if (table_index == 0) return;
+				if (table_index == 255) { v += A(1.0); return; }
+				v += A(get_mc_vol(table_index, e));
+				a += A(get_mc_area(table_index, e));
+			});
+			vol[b] = v;
+			area[b] = a;
+		});
+		for (const iType b : dirty_bricks) dirty[b] = 0;
+		dirty_bricks.clear();
+	}
+
+	template<typename Executor = ThreadExecutor>
+	A get_vol(const T* phi, const Executor& exec = Executor())
+	{
+		update(phi, exec);
+		return get_pairwise_sum(vol.data(), vol.size());
+	}
+
+	template<typename Executor = ThreadExecutor>
+	A get_area(const T* phi, const Executor& exec = Executor())
+	{
+		update(phi, exec);
+		return get_pairwise_sum(area.data(), area.size());
+	}
+
+private:
+	void mark_brick(const iType b)
+	{
+		if (dirty[b]) return;
+		dirty[b] = 1;
+		dirty_bricks.push_back(b);
+	}
+};
+
+//=================================================================================================
+//		case-binned grid
+//=================================================================================================
+
+//two-pass evaluation: the cells are first classified into bins of their canonical case
+//(with the edge fractions already rotated by get_rotated_vals), and then the kernel of each
+//canonical case runs over its whole bin, so the kernel is not dispatched per cell.
+//the bins are flushed after every z-layer of cells to keep the memory bounded.
+//the result can differ in the last bits from get_mc_vol_grid/get_mc_area_grid due to the summation order
+template<typename T>
+using MCBins = std::array<std::vector<std::array<T, 12>>, mc_canonical_cases.size()>;
+
+template<bool vol, std::size_t B, typename A, typename T>
+A get_mc_bin_sum(const std::vector<std::array<T, 12>>& cells)
+{
+	constexpr iType N = mc_canonical_cases[B][0], M = mc_canonical_cases[B][1];
+	A sum = 0.0;
+	for (const std::array<T, 12>& e : cells) {
+		if constexpr (vol) sum += A(get_mc_vol_case<N, M>(e));
+		else sum += A(get_mc_area_case<N, M>(e));
+	}
+	return sum;
+}
+
+template<bool vol, typename A, typename T, std::size_t... B>
+A get_mc_bins_sum(const MCBins<T>& bins, std::index_sequence<B...>)
+{
+	A sum = 0.0;
+	((sum += get_mc_bin_sum<vol, B, A>(bins[B])), ...);
+	return sum;
+}
+
+//bin (index into mc_canonical_cases) of each table index
+constexpr std::array<iType, 256> mc_case_bins = []() {
+	std::array<iType, 256> bins{};
+	for (iType i = 0; i < 256; ++i) bins[i] = mc_case_table[i].C;
+	return bins;
+}();
+
+template<bool vol, typename T, typename A>
+A get_mc_grid_binned(const T* phi, const iType nx, const iType ny, const iType nz)
+{
+	MCBins<T> bins;
+	iType num_full = 0, layer = 0;
+	A sum = 0.0;
+	const auto flush = [&]() {
+		sum += get_mc_bins_sum<vol, A>(bins, std::make_index_sequence<mc_canonical_cases.size()>());
+		if constexpr (vol) sum += A(num_full);
+		for (std::vector<std::array<T, 12>>& cells : bins) cells.clear();
+		num_full = 0;
+	};
+	for_each_mc_cell(phi, nx, ny, nz, [&](iType, iType, const iType k, const iType table_index, const std::array<T, 12>& e) {
+		if (k != layer) {
+			flush();
+			layer = k;
+		}
+		if (table_index == 0) return;
+		if (table_index == 255) { ++num_full; return; }
+		bins[mc_case_bins[table_index]].push_back(get_rotated_vals(e, mc_case_table[table_index].R));
+	});
+	flush();
+	return sum;
+}
+
+template<typename T, typename A = T>
+A get_mc_vol_grid_binned(const T* phi, const iType nx, const iType ny, const iType nz)
+{
+	return get_mc_grid_binned<true, T, A>(phi, nx, ny, nz);
+}
+
+template<typename T, typename A = T>
+A get_mc_area_grid_binned(const T* phi, const iType nx, const iType ny, const iType nz)
+{
+	return get_mc_grid_binned<false, T, A>(phi, nx, ny, nz);
+}
+
+//=================================================================================================
+//		brick pyramid
+//=================================================================================================
+
+//min/max of phi over bricks of mc_pyramid_brick^3 cells (level 0), of mc_pyramid_brick^3 level-0 bricks (level 1),
+//and so on until one brick covers the grid. a brick whose nodes are all inside (max < iso_value) is credited
+//with its cell count as volume and no area, one whose nodes are all outside (min >= iso_value) is skipped,
+//and only the cells of level-0 bricks straddling the surface are evaluated.
+//the result can differ in the last bits from get_mc_vol_grid/get_mc_area_grid due to the summation order
+constexpr iType mc_pyramid_brick = 8;
+
+template<typename T>
+struct MCPyramidLevel
+{
+	iType bx, by, bz;//brick counts
+	iType size;//cells per brick side
+	std::vector<T> lo, hi;//min/max of the nodes of brick i + bx * (j + by * k)
+};
+
+template<typename T = fType>
+struct MCPyramid
+{
+	iType nx = 0, ny = 0, nz = 0;
+	std::vector<MCPyramidLevel<T>> levels;//levels[0] is the finest
+
+	MCPyramid() = default;
+	MCPyramid(const T* phi, const iType nx, const iType ny, const iType nz) { build(phi, nx, ny, nz); }
+
+	void build(const T* phi, const iType nx_, const iType ny_, const iType nz_)
+	{
+		nx = nx_;
+		ny = ny_;
+		nz = nz_;
+		levels.clear();
+		if (nx < 2 || ny < 2 || nz < 2) return;
+		for (iType size = mc_pyramid_brick;; size *= mc_pyramid_brick) {
+			const auto count = [size](const iType n) { return (n - 1 + size - 1) / size; };
+			MCPyramidLevel<T> level{ count(nx), count(ny), count(nz), size, {}, {} };
+			level.lo.resize(std::size_t(level.bx) * level.by * level.bz);
+			level.hi.resize(level.lo.size());
+			levels.push_back(std::move(level));
+			if (levels.back().lo.size() == 1) break;
+		}
+		update(phi, MCBox{ 0, 0, 0, nx, ny, nz });
+	}
+
+	//recomputes the bricks containing the nodes [i0, i1) x [j0, j1) x [k0, k1) after phi has changed there
+	void update(const T* phi, const MCBox& nodes)
+	{
+		if (levels.empty()) return;
+		const MCPyramidLevel<T>& l0 = levels[0];
+		//node i is shared by the bricks b with size * b <= i <= size * (b + 1)
+		MCBox b{
+			std::max(nodes.i0 - 1, 0) / l0.size, std::max(nodes.j0 - 1, 0) / l0.size, std::max(nodes.k0 - 1, 0) / l0.size,
+			std::min((nodes.i1 - 1) / l0.size, l0.bx - 1), std::min((nodes.j1 - 1) / l0.size, l0.by - 1), std::min((nodes.k1 - 1) / l0.size, l0.bz - 1) };
+		for (iType bk = b.k0; bk <= b.k1; ++bk) {
+			for (iType bj = b.j0; bj <= b.j1; ++bj) {
+				for (iType bi = b.i0; bi <= b.i1; ++bi) {
+					const MCBox c = get_box(0, bi + l0.bx * (bj + l0.by * bk));
+					T lo = phi[c.i0 + std::size_t(nx) * (c.j0 + std::size_t(ny) * c.k0)], hi = lo;
+					for (iType k = c.k0; k <= c.k1; ++k) {
+						for (iType j = c.j0; j <= c.j1; ++j) {
+							const T* row = phi + std::size_t(nx) * (j + std::size_t(ny) * k);
+							for (iType i = c.i0; i <= c.i1; ++i) {
+								lo = std::min(lo, row[i]);
+								hi = std::max(hi, row[i]);
+							}
+						}
+					}
+					set(0, bi, bj, bk, lo, hi);
+				}
+			}
+		}
+
+		for (std::size_t l = 1; l < levels.size(); ++l) {
+			const MCPyramidLevel<T>& child = levels[l - 1];
+			const MCPyramidLevel<T>& parent = levels[l];
+			b = { b.i0 / mc_pyramid_brick, b.j0 / mc_pyramid_brick, b.k0 / mc_pyramid_brick,
+				b.i1 / mc_pyramid_brick, b.j1 / mc_pyramid_brick, b.k1 / mc_pyramid_brick };
+			for (iType bk = b.k0; bk <= b.k1; ++bk) {
+				for (iType bj = b.j0; bj <= b.j1; ++bj) {
+					for (iType bi = b.i0; bi <= b.i1; ++bi) {
+						const MCBox c = get_children(l, bi + parent.bx * (bj + parent.by * bk));
+						T lo = child.lo[c.i0 + std::size_t(child.bx) * (c.j0 + std::size_t(child.by) * c.k0)], hi = lo;
+						for (iType k = c.k0; k < c.k1; ++k) {
+							for (iType j = c.j0; j < c.j1; ++j) {
+								for (iType i = c.i0; i < c.i1; ++i) {
+									const std::size_t n = i + std::size_t(child.bx) * (j + std::size_t(child.by) * k);
+									lo = std::min(lo, child.lo[n]);
+									hi = std::max(hi, child.hi[n]);
+								}
+							}
+						}
+						set(l, bi, bj, bk, lo, hi);
+					}
+				}
+			}
+		}
+	}
+
+	//cells [i0, i1) x [j0, j1) x [k0, k1) of brick b at level l; its nodes are [i0, i1] x [j0, j1] x [k0, k1]
+	MCBox get_box(const std::size_t l, const std::size_t b) const
+	{
+		const MCPyramidLevel<T>& level = levels[l];
+		const iType i0 = iType(b % level.bx) * level.size;
+		const iType j0 = iType(b / level.bx % level.by) * level.size;
+		const iType k0 = iType(b / level.bx / level.by) * level.size;
+		return { i0, j0, k0,
+			std::min(i0 + level.size, nx - 1), std::min(j0 + level.size, ny - 1), std::min(k0 + level.size, nz - 1) };
+	}
+
+	//bricks [i0, i1) x [j0, j1) x [k0, k1) of level l - 1 covered by brick b at level l
+	MCBox get_children(const std::size_t l, const std::size_t b) const
+	{
+		const MCPyramidLevel<T>& level = levels[l];
+		const MCPyramidLevel<T>& child = levels[l - 1];
+		const iType i0 = iType(b % level.bx) * mc_pyramid_brick;
+		const iType j0 = iType(b / level.bx % level.by) * mc_pyramid_brick;
+		const iType k0 = iType(b / level.bx / level.by) * mc_pyramid_brick;
+		return { i0, j0, k0,
+			std::min(i0 + mc_pyramid_brick, child.bx), std::min(j0 + mc_pyramid_brick, child.by), std::min(k0 + mc_pyramid_brick, child.bz) };
+	}
+
+private:
+	void set(const std::size_t l, const iType bi, const iType bj, const iType bk, const T lo, const T hi)
+	{
+		MCPyramidLevel<T>& level = levels[l];
+		const std::size_t n = bi + std::size_t(level.bx) * (bj + std::size_t(level.by) * bk);
+		level.lo[n] = lo;
+		level.hi[n] = hi;
+	}
+};
+
+//calls inside(box) for the largest bricks that are fully inside and mixed(box) for the bricks
+//straddling the surface, in a fixed order
+template<typename T, typename Inside, typename Mixed>
+void for_each_mc_pyramid_brick(const MCPyramid<T>& pyramid, const std::size_t l, const std::size_t b, Inside&& inside, Mixed&& mixed)
+{
+	const MCPyramidLevel<T>& level = pyramid.levels[l];
+	if (level.lo[b] >= iso_value) return;
+	if (level.hi[b] < iso_value) { inside(pyramid.get_box(l, b)); return; }
+	if (l == 0) { mixed(pyramid.get_box(l, b)); return; }
+
+	//a level-1 brick none of whose level-0 bricks can be skipped is walked as a whole,
+	//which saves the setup of the smaller boxes where the surface is dense
+	const MCPyramidLevel<T>& child = pyramid.levels[l - 1];
+	const MCBox c = pyramid.get_children(l, b);
+	bool skip = l > 1;
+	for (iType k = c.k0; k < c.k1 && !skip; ++k) {
+		for (iType j = c.j0; j < c.j1 && !skip; ++j) {
+			for (iType i = c.i0; i < c.i1 && !skip; ++i) {
+				const std::size_t n = i + std::size_t(child.bx) * (j + std::size_t(child.by) * k);
+				skip = child.lo[n] >= iso_value || child.hi[n] < iso_value;
+			}
+		}
+	}
+	if (!skip) { mixed(pyramid.get_box(l, b)); return; }
+
+	for (iType k = c.k0; k < c.k1; ++k)
+		for (iType j = c.j0; j < c.j1; ++j)
+			for (iType i = c.i0; i < c.i1; ++i)
+				for_each_mc_pyramid_brick(pyramid, l - 1, i + std::size_t(child.bx) * (j + std::size_t(child.by) * k), inside, mixed);
+}
+
+template<typename T, typename Inside, typename Mixed>
+void for_each_mc_pyramid_brick(const MCPyramid<T>& pyramid, Inside&& inside, Mixed&& mixed)
+{
+	if (pyramid.levels.empty()) return;
+	for_each_mc_pyramid_brick(pyramid, pyramid.levels.size() - 1, 0, inside, mixed);
+}
+
+//phi has to match the pyramid, i.e., the pyramid has to be built or updated after every change of phi
+template<typename T, typename A = T>
+A get_mc_vol_grid(const MCPyramid<T>& pyramid, const T* phi)
+{
+	A vol = 0.0;
+	for_each_mc_pyramid_brick(pyramid,
+		[&vol](const MCBox& box) { vol += A(box.i1 - box.i0) * A(box.j1 - box.j0) * A(box.k1 - box.k0); },
+		[&](const MCBox& box) { vol += get_mc_vol_grid<T, A>(phi, pyramid.nx, pyramid.ny, box); });
+	return vol;
+}
+
+template<typename T, typename A = T>
+A get_mc_area_grid(const MCPyramid<T>& pyramid, const T* phi)
+{
+	A area = 0.0;
+	for_each_mc_pyramid_brick(pyramid,
+		[](const MCBox&) {},
+		[&](const MCBox& box) { area += get_mc_area_grid<T, A>(phi, pyramid.nx, pyramid.ny, box); });
+	return area;
+}
+
+//=================================================================================================
+//		ms-style image
+//=================================================================================================
+
+//a 2D image of nx * ny nodes with node (i, j) at phi[i + stride * j], and quad (i, j) with the corners
+//(i, j), (i+1, j), (i+1, j+1), (i, j+1) as in S4. the rows of quads are split into fixed bands of
+//ms_band_rows rows, each band is summed serially, and the band sums are added in a fixed pairwise order,
+//so the result does not depend on the number of threads
+constexpr iType ms_band_rows = 64;
+
+//sign bits and horizontal edge fractions of one row of nodes
+template<typename T>
+struct MSRow
+{
+	std::vector<std::uint8_t> sign;//1 if inside
+	std::vector<T> ex;//edge (i, j)-(i+1, j)
+
+	void load(const T* row, const iType nx)
+	{
+		sign.resize(nx);
+		ex.resize(nx);
+		for (iType i = 0; i < nx; ++i) sign[i] = row[i] < iso_value;
+		for (iType i = 0; i + 1 < nx; ++i) ex[i] = sign[i] != sign[i + 1] ? get_len_frac(row[i], row[i + 1]) : T(sign[i]);
+	}
+};
+
+//area and perimeter of the quads of the rows [j0, j1); each edge fraction is computed once and shared
+//by the two quads of the edge. quad_area/quad_len[i + (nx - 1) * j] receive the values of each quad if not null
+template<typename T, typename A = T>
+void get_ms_image_rows(const T* phi, const iType nx, const iType stride, const iType j0, const iType j1, A& area, A& len,
+	std::remove_const_t<T>* quad_area = nullptr, std::remove_const_t<T>* quad_len = nullptr)
+{
+	area = len = A(0.0);
+	if (nx < 2 || j1 <= j0) return;
+	MSRow<T> rows[2];
+	std::vector<T> ey(nx);//edge (i, j)-(i, j+1)
+	rows[0].load(phi + std::size_t(stride) * j0, nx);
+	for (iType j = j0; j < j1; ++j) {
+		const T* r0 = phi + std::size_t(stride) * j;
+		const T* r1 = r0 + stride;
+		const MSRow<T>& lo = rows[(j - j0) & 1];
+		MSRow<T>& hi = rows[(j - j0 + 1) & 1];
+		hi.load(r1, nx);
+		for (iType i = 0; i < nx; ++i) ey[i] = lo.sign[i] != hi.sign[i] ? get_len_frac(r0[i], r1[i]) : T(lo.sign[i]);
+
+		A row_area = 0.0, row_len = 0.0;
+		for (iType i = 0; i + 1 < nx; ++i) {
+			const iType table_index = lo.sign[i] | (lo.sign[i + 1] << 1) | (hi.sign[i + 1] << 2) | (hi.sign[i] << 3);
+			if (table_index == 0 && !quad_area && !quad_len) continue;
+			T a = T(table_index == 15), l = T(0.0);
+			if (table_index != 0 && table_index != 15) {
+				const std::array<T, 4> e{ lo.ex[i], ey[i + 1], hi.ex[i], ey[i] };
+				const bool negative = (table_index == 5 || table_index == 10) && r0[i] + r0[i + 1] + r1[i + 1] + r1[i] < 0;
+				a = get_ms_area(table_index, e, negative);
+				l = get_ms_len(table_index, e, negative);
+			}
+			row_area += A(a);
+			row_len += A(l);
+			if (quad_area) quad_area[i + std::size_t(nx - 1) * j] = a;
+			if (quad_len) quad_len[i + std::size_t(nx - 1) * j] = l;
+		}
+		area += row_area;
+		len += row_len;
+	}
+}
+
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+void get_ms_image(const T* phi, const iType nx, const iType ny, const iType stride, A& area, A& len,
+	std::remove_const_t<T>* quad_area = nullptr, std::remove_const_t<T>* quad_len = nullptr, const Executor& exec = Executor())
+{
+	area = len = A(0.0);
+	if (nx < 2 || ny < 2) return;
+	const iType num_bands = (ny - 1 + ms_band_rows - 1) / ms_band_rows;
+	std::vector<A> band_area(num_bands), band_len(num_bands);
+	exec(num_bands, [&](const iType b) {
+		get_ms_image_rows<T, A>(phi, nx, stride, b * ms_band_rows, std::min((b + 1) * ms_band_rows, ny - 1), band_area[b], band_len[b], quad_area, quad_len);
+	});
+	area = get_pairwise_sum(band_area.data(), band_area.size());
+	len = get_pairwise_sum(band_len.data(), band_len.size());
+}
+
+//=================================================================================================
+//		connected components
+//=================================================================================================
+
+//volume and area of a connected inside region (a droplet or a bubble) in grid coordinates,
+//and its node with the smallest index i + nx * (j + ny * k)
+template<typename T = fType>
+struct MCComponent
+{
+	T vol = T(0.0);
+	T area = T(0.0);
+	std::int64_t node = 0;
+};
+
+//union-find over the nodes of a grid (up to 2^32 nodes) that can be shared by threads.
+//a root is always linked below the smaller root, so the root of a set is its smallest node
+//whatever the order of the unions, and find halves the paths with a compare-and-swap
+struct MCNodeForest
+{
+	static constexpr std::size_t max_node = std::numeric_limits<std::uint32_t>::max();//largest node id
+
+	std::vector<std::atomic<std::uint32_t>> parent;
+
+	explicit MCNodeForest(const std::size_t n) : parent(n) {}
+
+	std::uint32_t find(std::uint32_t x)
+	{
+		for (;;) {
+			std::uint32_t p = parent[x].load(std::memory_order_relaxed);
+			if (p == x) return x;
+			const std::uint32_t g = parent[p].load(std::memory_order_relaxed);
+			if (g != p) parent[x].compare_exchange_weak(p, g, std::memory_order_relaxed);
+			x = g;
+		}
+	}
+
+	void unite(std::uint32_t a, std::uint32_t b)
+	{
+		for (;;) {
+			a = find(a);
+			b = find(b);
+			if (a == b) return;
+			if (a < b) std::swap(a, b);
+			std::uint32_t expected = a;
+			if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return;
+		}
+	}
+};
+
+//the connected inside regions of a grid with the volume and area of each, ordered by their smallest node.
+//the regions are the inside nodes connected by grid edges (see mc_pieces_table), labeled with a parallel
+//union-find in one pass over the node layers. the cells are then evaluated once brick by brick, and each piece
+//of a cell adds its get_mc_vol/get_mc_area share (get_mc_piece_measures) to the label of its corners.
+//labels (optional, nx * ny * nz) receives the index of the region of each inside node and -1 elsewhere.
+//the result does not depend on the number of threads or on the scheduling, and the region sums add up to
+//get_mc_vol_grid/get_mc_area_grid up to rounding. the nodes are numbered with 32-bit ids in MCNodeForest,
+//so a grid of more than 2^32 nodes is rejected (an assertion in debug builds) and gives no regions
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+std::vector<MCComponent<A>> get_mc_components(const T* phi, const iType nx, const iType ny, const iType nz,
+	iType* labels = nullptr, const Executor& exec = Executor())
+{
+	std::vector<MCComponent<A>> components;
+	if (nx < 1 || ny < 1 || nz < 1) return components;
+	const std::size_t nxy = std::size_t(nx) * ny, n = nxy * nz;
+	assert(n - 1 <= MCNodeForest::max_node);
+	if (n - 1 > MCNodeForest::max_node) return components;
+	std::vector<iType> own_labels;
+	if (!labels) {
+		own_labels.resize(n);
+		labels = own_labels.data();
+	}
+
+	MCNodeForest forest(n);
+	exec(nz, [&](const iType k) {
+		for (std::size_t m = nxy * k; m < nxy * (k + 1); ++m) forest.parent[m].store(std::uint32_t(m), std::memory_order_relaxed);
+	});
+	exec(nz, [&](const iType k) {
+		for (iType j = 0; j < ny; ++j) {
+			const std::size_t row = nxy * k + std::size_t(nx) * j;
+			for (iType i = 0; i < nx; ++i) {
+				const std::size_t m = row + i;
+				if (!(phi[m] < iso_value)) continue;
+				if (i + 1 < nx && phi[m + 1] < iso_value) forest.unite(std::uint32_t(m), std::uint32_t(m + 1));
+				if (j + 1 < ny && phi[m + nx] < iso_value) forest.unite(std::uint32_t(m), std::uint32_t(m + nx));
+				if (k + 1 < nz && phi[m + nxy] < iso_value) forest.unite(std::uint32_t(m), std::uint32_t(m + nxy));
+			}
+		}
+	});
+
+	//the roots are numbered in node order, layer by layer
+	std::vector<iType> first(std::size_t(nz) + 1, 0);
+	exec(nz, [&](const iType k) {
+		for (std::size_t m = nxy * k; m < nxy * (k + 1); ++m) first[k + 1] += phi[m] < iso_value && forest.find(std::uint32_t(m)) == m;
+	});
+	for (iType k = 0; k < nz; ++k) first[k + 1] += first[k];
+	components.resize(first[nz]);
+	exec(nz, [&](const iType k) {
+		iType label = first[k];
+		for (std::size_t m = nxy * k; m < nxy * (k + 1); ++m) {
+			labels[m] = -1;
+			if (phi[m] < iso_value && forest.find(std::uint32_t(m)) == m) {
+				components[label].node = std::int64_t(m);
+				labels[m] = label++;
+			}
+		}
+	});
+	exec(nz, [&](const iType k) {
+		for (std::size_t m = nxy * k; m < nxy * (k + 1); ++m) {
+			if (phi[m] < iso_value) labels[m] = labels[forest.find(std::uint32_t(m))];
+		}
+	});
+	if (nx < 2 || ny < 2 || nz < 2) return components;
+
+	//partial sums of each brick, merged in brick order
+	const iType num_bricks = get_mc_brick_count(nx) * get_mc_brick_count(ny) * get_mc_brick_count(nz);
+	std::vector<std::vector<std::pair<iType, MCComponent<A>>>> partial(num_bricks);
+	exec(num_bricks, [&](const iType b) {
+		std::vector<std::pair<iType, MCComponent<A>>>& sums = partial[b];
+		const auto add = [&sums](const iType label, const A vol, const A area) {
+			if (sums.empty() || sums.back().first != label) sums.emplace_back(label, MCComponent<A>());
+			sums.back().second.vol += vol;
+			sums.back().second.area += area;
+		};
+		for_each_mc_cell(phi, nx, ny, get_mc_brick(nx, ny, nz, b),
+			[&](const iType i, const iType j, const iType k, const iType table_index, const std::array<T, 12>& e) {
+			if (table_index == 0) return;
+			const std::size_t m = std::size_t(i) + std::size_t(nx) * j + nxy * k;
+			const auto get_label = [&](const iType corners) {
+				iType c = 0;
+				while (!((corners >> c) & 1)) ++c;
+				return labels[m + mc_corners[c][0] + std::size_t(nx) * mc_corners[c][1] + nxy * mc_corners[c][2]];
+			};
+			const MCPieces& pieces = mc_pieces_table[table_index];
+			if (table_index == 255) add(labels[m], A(1.0), A(0.0));
+			else if (pieces.num == 1) add(get_label(table_index), A(get_mc_vol(table_index, e)), A(get_mc_area(table_index, e)));
+			else {
+				std::array<T, 4> vol, area;
+				get_mc_piece_measures(table_index, e, vol, area);
+				for (iType q = 0; q < pieces.num; ++q) add(get_label(pieces.corners[q]), A(vol[q]), A(area[q]));
+			}
+		});
+	});
+	for (const std::vector<std::pair<iType, MCComponent<A>>>& sums : partial) {
+		for (const std::pair<iType, MCComponent<A>>& s : sums) {
+			components[s.first].vol += s.second.vol;
+			components[s.first].area += s.second.area;
+		}
+	}
+	return components;
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+}
+
+#endif
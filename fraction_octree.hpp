@@ -0,0 +1,230 @@
+/*
+Copyright(c) 2021, Tetsuya Takahashi and Christopher Batty
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this softwareand associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright noticeand this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef FRACTION_OCTREE_HPP
+#define FRACTION_OCTREE_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "fraction_grid.hpp"
+
+namespace Fraction
+{
+
+//=================================================================================================
+//		octree
+//=================================================================================================
+
+//an octree over the root cube [origin, origin + size]^3 with leaves down to max_level (edge length size / 2^level).
+//cell 0 is the root, and the children of a cell are stored consecutively in the order di + 2 * (dj + 2 * dk).
+//every leaf holds the values at its 8 corners (in the order of S8), so the kernels run on the leaves directly.
+//nodes are addressed by integer coordinates of the finest level, [0, 2^max_level]^3
+template<typename T = fType>
+struct MCOctree
+{
+	static constexpr std::int32_t leaf = -1;
+
+	std::array<T, 3> origin{};
+	T size = T(1.0);
+	iType max_level = 0;//at most 30
+	std::vector<std::int32_t> child{ leaf };//index of the first child of each cell, or leaf
+	std::vector<std::array<T, 8>> corners{ std::array<T, 8>{} };//corner values of each leaf (unused for the other cells)
+
+	MCOctree() = default;
+	MCOctree(const std::array<T, 3>& origin, const T size, const iType max_level) : origin(origin), size(size), max_level(max_level) {}
+
+	//splits leaf c into 8 leaves and returns the index of the first
+	std::int32_t split(const std::int32_t c)
+	{
+		const std::int32_t first = std::int32_t(child.size());
+		child[c] = first;
+		child.resize(child.size() + 8, leaf);
+		corners.resize(child.size());
+		return first;
+	}
+
+	//splits the cells for which refine(level, lower corner, edge length) holds, down to max_level,
+	//sets the corners of the leaves to f(x, y, z), and constrains the hanging nodes
+	template<typename F, typename R>
+	void build(F&& f, R&& refine)
+	{
+		child.assign(1, leaf);
+		corners.assign(1, std::array<T, 8>{});
+		build(0, 0, std::array<iType, 3>{ 0, 0, 0 }, f, refine);
+		constrain();
+	}
+
+	//leaf containing the finest-level cell (x, y, z), with its level and its cell coordinates at that level
+	std::int32_t find_leaf(const iType x, const iType y, const iType z, iType& level, std::array<iType, 3>& c) const
+	{
+		std::int32_t cell = 0;
+		level = 0;
+		c = { 0, 0, 0 };
+		while (child[cell] != leaf) {
+			const iType s = max_level - level - 1;
+			const iType di = (x >> s) & 1, dj = (y >> s) & 1, dk = (z >> s) & 1;
+			cell = child[cell] + di + 2 * (dj + 2 * dk);
+			c = { 2 * c[0] + di, 2 * c[1] + dj, 2 * c[2] + dk };
+			++level;
+		}
+		return cell;
+	}
+
+	//replaces the value of every hanging node, a leaf corner inside an edge or a face of a coarser leaf,
+	//by the trilinear interpolation of the corners of the coarsest leaf touching it (linear on an edge,
+	//bilinear on a face of that leaf). all leaves around the node then see the same value, and the fine and
+	//coarse cells of a transition share their edge crossings. call it after setting the corners of the leaves
+	void constrain()
+	{
+		std::vector<std::vector<std::pair<std::int32_t, std::array<iType, 3>>>> levels(max_level + 1);
+		for_each_cell(0, 0, std::array<iType, 3>{ 0, 0, 0 }, [&](const std::int32_t cell, const iType level, const std::array<iType, 3>& c) {
+			levels[level].push_back({ cell, c });
+		});
+		//coarse leaves first, so that the corners they pass on are already constrained
+		for (iType level = 0; level <= max_level; ++level) {
+			for (const auto& [cell, c] : levels[level]) {
+				const iType s = max_level - level;
+				for (iType n = 0; n < 8; ++n)
+					constrain_corner(cell, (c[0] + mc_corners[n][0]) << s, (c[1] + mc_corners[n][1]) << s, (c[2] + mc_corners[n][2]) << s, n, level);
+			}
+		}
+	}
+
+private:
+	template<typename F>
+	void for_each_cell(const std::int32_t cell, const iType level, const std::array<iType, 3>& c, F&& f) const
+	{
+		if (child[cell] == leaf) {
+			f(cell, level, c);
+			return;
+		}
+		for (iType d = 0; d < 8; ++d)
+			for_each_cell(child[cell] + d, level + 1, std::array<iType, 3>{ 2 * c[0] + (d & 1), 2 * c[1] + ((d >> 1) & 1), 2 * c[2] + ((d >> 2) & 1) }, f);
+	}
+
+	void constrain_corner(const std::int32_t cell, const iType x, const iType y, const iType z, const iType n, const iType level)
+	{
+		const iType size_n = iType(1) << max_level;
+		iType coarse_level = level;
+		std::int32_t coarse = cell;
+		std::array<iType, 3> c{};
+		for (iType d = 0; d < 8; ++d) {
+			const iType cx = x - (d & 1), cy = y - ((d >> 1) & 1), cz = z - ((d >> 2) & 1);
+			if (cx < 0 || cy < 0 || cz < 0 || cx >= size_n || cy >= size_n || cz >= size_n) continue;
+			iType l;
+			std::array<iType, 3> lc;
+			const std::int32_t found = find_leaf(cx, cy, cz, l, lc);
+			if (l < coarse_level) {
+				coarse_level = l;
+				coarse = found;
+				c = lc;
+			}
+		}
+		if (coarse == cell) return;
+		const iType s = max_level - coarse_level;
+		const iType h = iType(1) << s;
+		const T f[3] = { T(x - (c[0] << s)) / T(h), T(y - (c[1] << s)) / T(h), T(z - (c[2] << s)) / T(h) };
+		if ((f[0] == T(0.0) || f[0] == T(1.0)) && (f[1] == T(0.0) || f[1] == T(1.0)) && (f[2] == T(0.0) || f[2] == T(1.0))) return;
+		T value = T(0.0);
+		for (iType m = 0; m < 8; ++m) {
+			T w = T(1.0);
+			for (iType a = 0; a < 3; ++a) w *= mc_corners[m][a] ? f[a] : T(1.0) - f[a];
+			value += w * corners[coarse][m];
+		}
+		corners[cell][n] = value;
+	}
+
+	template<typename F, typename R>
+	void build(const std::int32_t cell, const iType level, const std::array<iType, 3>& c, F& f, R& refine)
+	{
+		const T h = size / T(iType(1) << level);
+		if (level < max_level && refine(level, std::array<T, 3>{ origin[0] + h * c[0], origin[1] + h * c[1], origin[2] + h * c[2] }, h)) {
+			const std::int32_t first = split(cell);
+			for (iType d = 0; d < 8; ++d)
+				build(first + d, level + 1, std::array<iType, 3>{ 2 * c[0] + (d & 1), 2 * c[1] + ((d >> 1) & 1), 2 * c[2] + ((d >> 2) & 1) }, f, refine);
+			return;
+		}
+		for (iType n = 0; n < 8; ++n) {
+			corners[cell][n] = f(origin[0] + h * (c[0] + mc_corners[n][0]), origin[1] + h * (c[1] + mc_corners[n][1]),
+				origin[2] + h * (c[2] + mc_corners[n][2]));
+		}
+	}
+};
+
+//calls f(level, corner values) for the leaves of the subtree of cell
+template<typename T, typename F>
+void for_each_mc_octree_leaf(const MCOctree<T>& tree, const std::int32_t cell, const iType level, F&& f)
+{
+	if (tree.child[cell] == MCOctree<T>::leaf) {
+		f(level, tree.corners[cell]);
+		return;
+	}
+	for (iType d = 0; d < 8; ++d) for_each_mc_octree_leaf(tree, tree.child[cell] + d, level + 1, f);
+}
+
+//subtrees evaluated as separate tasks: the cells at mc_octree_task_level and the leaves above it
+constexpr iType mc_octree_task_level = 3;
+
+//volume and area of the inside in world units: the kernels are evaluated on the 8 corners of each leaf
+//and scaled by h^3 and h^2 for its edge length h. the subtrees run in parallel, and their sums are
+//added in a fixed pairwise order, so the result does not depend on the number of threads
+template<typename T, typename A = T, typename Executor = ThreadExecutor>
+void get_mc_octree(const MCOctree<T>& tree, A& vol, A& area, const Executor& exec = Executor())
+{
+	std::vector<std::pair<std::int32_t, iType>> tasks;//cell and level of the subtrees
+	const auto collect = [&](const auto& self, const std::int32_t cell, const iType level) -> void {
+		if (tree.child[cell] == MCOctree<T>::leaf || level == mc_octree_task_level) {
+			tasks.push_back({ cell, level });
+			return;
+		}
+		for (iType d = 0; d < 8; ++d) self(self, tree.child[cell] + d, level + 1);
+	};
+	collect(collect, 0, 0);
+
+	std::vector<A> partial_vol(tasks.size()), partial_area(tasks.size());
+	exec(iType(tasks.size()), [&](const iType t) {
+		A v = 0.0, a = 0.0;
+		for_each_mc_octree_leaf(tree, tasks[t].first, tasks[t].second, [&](const iType level, const std::array<T, 8>& c) {
+			const iType table_index = get_mc_table_index(c);
+			if (table_index == 0) return;
+			const T h = tree.size / T(iType(1) << level);
+			if (table_index == 255) { v += A(h * h * h); return; }
+			v += A(h * h * h * get_mc_vol(table_index, c));
+			a += A(h * h * get_mc_area(table_index, c));
+		});
+		partial_vol[t] = v;
+		partial_area[t] = a;
+	});
+	vol = get_pairwise_sum(partial_vol.data(), partial_vol.size());
+	area = get_pairwise_sum(partial_area.data(), partial_area.size());
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+}
+
+#endif
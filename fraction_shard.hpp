@@ -0,0 +1,296 @@
+/*
+Copyright(c) 2021, Tetsuya Takahashi and Christopher Batty
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this softwareand associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright noticeand this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef FRACTION_SHARD_HPP
+#define FRACTION_SHARD_HPP
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "fraction_grid.hpp"
+
+//POSIX systems run the ranks of get_mc_shards_local as processes sharing anonymous memory;
+//define FRACTION_NO_POSIX to run them one after the other in this process instead
+#if !defined(FRACTION_NO_POSIX) && (defined(__unix__) || defined(__APPLE__))
+#ifndef FRACTION_POSIX
+#define FRACTION_POSIX
+#endif
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace Fraction
+{
+
+//=================================================================================================
+//		sharded grid
+//=================================================================================================
+
+//compensated (Neumaier) sum that can be used as the accumulator A of the grid reductions.
+//the rounding error of every addition is kept in c, so that partial sums can be merged
+//in any grouping with an error independent of the number of cells and shards
+template<typename T = fType>
+struct MCSum
+{
+	T sum = T(0.0);
+	T c = T(0.0);
+
+	MCSum() = default;
+	MCSum(const T x) : sum(x) {}
+
+	MCSum& operator+=(const MCSum& x)
+	{
+		const T s = sum + x.sum;
+		c += std::abs(sum) >= std::abs(x.sum) ? (sum - s) + x.sum : (x.sum - s) + sum;
+		c += x.c;
+		sum = s;
+		return *this;
+	}
+
+	friend MCSum operator+(MCSum l, const MCSum& r) { return l += r; }
+
+	T get() const { return sum + c; }
+};
+
+//a sub-block of a grid of nx * ny * nz nodes owned by one rank. every cell is owned by the shard
+//that owns its corner 0 (its lowest node), so the shards of a partition of the nodes count every
+//cell exactly once; a shard evaluates its cells from its nodes and a halo of one node on the upper side
+struct MCShard
+{
+	iType nx = 0, ny = 0, nz = 0;
+	MCBox nodes;//owned nodes [i0, i1) x [j0, j1) x [k0, k1) in global indices
+};
+
+//shard rank of px * py * pz shards splitting the nodes evenly, rank = a + px * (b + py * c)
+inline MCShard get_mc_shard(const iType nx, const iType ny, const iType nz, const iType px, const iType py, const iType pz, const iType rank)
+{
+	const auto split = [](const iType n, const iType p, const iType r) { return iType(std::int64_t(n) * r / p); };
+	const iType a = rank % px, b = rank / px % py, c = rank / px / py;
+	return { nx, ny, nz, MCBox{ split(nx, px, a), split(ny, py, b), split(nz, pz, c), split(nx, px, a + 1), split(ny, py, b + 1), split(nz, pz, c + 1) } };
+}
+
+//the owned nodes and the halo, which is clipped to the grid. the block of a shard stores these
+//nodes as (i - i0) + (i1 - i0) * ((j - j0) + (j1 - j0) * (k - k0))
+inline MCBox get_mc_shard_block(const MCShard& s)
+{
+	const MCBox& o = s.nodes;
+	if (o.i1 <= o.i0 || o.j1 <= o.j0 || o.k1 <= o.k0) return o;
+	return { o.i0, o.j0, o.k0, std::min(o.i1 + 1, s.nx), std::min(o.j1 + 1, s.ny), std::min(o.k1 + 1, s.nz) };
+}
+
+//the owned cells in the indices of the block
+inline MCBox get_mc_shard_cells(const MCShard& s)
+{
+	const MCBox& o = s.nodes;
+	return { 0, 0, 0, std::max(0, std::min(o.i1, s.nx - 1) - o.i0), std::max(0, std::min(o.j1, s.ny - 1) - o.j0),
+		std::max(0, std::min(o.k1, s.nz - 1) - o.k0) };
+}
+
+inline std::size_t get_mc_box_size(const MCBox& b)
+{
+	if (b.i1 <= b.i0 || b.j1 <= b.j0 || b.k1 <= b.k0) return 0;
+	return std::size_t(b.i1 - b.i0) * (b.j1 - b.j0) * (b.k1 - b.k0);
+}
+
+//copies the nodes in both src_box and dst_box from src (stored over src_box) to dst (stored over dst_box),
+//e.g., a shard's owned nodes into the halo of a neighbor, or a shard's block out of a global array
+template<typename T>
+void copy_mc_box_nodes(const MCBox& src_box, const T* src, const MCBox& dst_box, T* dst)
+{
+	const MCBox b{ std::max(src_box.i0, dst_box.i0), std::max(src_box.j0, dst_box.j0), std::max(src_box.k0, dst_box.k0),
+		std::min(src_box.i1, dst_box.i1), std::min(src_box.j1, dst_box.j1), std::min(src_box.k1, dst_box.k1) };
+	if (b.i1 <= b.i0 || b.j1 <= b.j0 || b.k1 <= b.k0) return;
+	const std::size_t sx = src_box.i1 - src_box.i0, sy = src_box.j1 - src_box.j0;
+	const std::size_t dx = dst_box.i1 - dst_box.i0, dy = dst_box.j1 - dst_box.j0;
+	for (iType k = b.k0; k < b.k1; ++k) {
+		for (iType j = b.j0; j < b.j1; ++j) {
+			const T* s = src + (b.i0 - src_box.i0) + sx * ((j - src_box.j0) + sy * (k - src_box.k0));
+			T* d = dst + (b.i0 - dst_box.i0) + dx * ((j - dst_box.j0) + dy * (k - dst_box.k0));
+			std::copy(s, s + (b.i1 - b.i0), d);
+		}
+	}
+}
+
+//partial result of a shard. it is trivially copyable, so it can be sent between ranks as bytes,
+//and the results of all shards are merged with get_mc_shard_sum
+struct MCShardResult
+{
+	MCSum<fType> vol, area;
+	std::uint64_t num_cells = 0;
+
+	MCShardResult& operator+=(const MCShardResult& r)
+	{
+		vol += r.vol;
+		area += r.area;
+		num_cells += r.num_cells;
+		return *this;
+	}
+
+	friend MCShardResult operator+(MCShardResult l, const MCShardResult& r) { return l += r; }
+};
+
+//volume and area of the cells owned by shard s, from its block (see get_mc_shard_block)
+template<typename T>
+MCShardResult get_mc_shard_result(const T* block, const MCShard& s)
+{
+	MCShardResult r;
+	const MCBox b = get_mc_shard_block(s);
+	const MCBox cells = get_mc_shard_cells(s);
+	if (get_mc_box_size(cells) == 0) return r;
+	for_each_mc_cell(block, b.i1 - b.i0, b.j1 - b.j0, cells, [&r](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+		++r.num_cells;
+		if (table_index == 0) return;
+		if (table_index == 255) { r.vol += fType(1.0); return; }
+		r.vol += fType(get_mc_vol(table_index, e));
+		r.area += fType(get_mc_area(table_index, e));
+	});
+	return r;
+}
+
+//merges the results of all shards in a fixed pairwise order (pass them in rank order)
+inline MCShardResult get_mc_shard_sum(const MCShardResult* r, const std::size_t n)
+{
+	return get_pairwise_sum(r, n);
+}
+
+//runs task(0), ..., task(num - 1) as child processes and waits for them (one after the other in this
+//process without POSIX). returns false if a process could not be started, threw, or failed
+template<typename F>
+bool run_mc_processes(const iType num, F&& task)
+{
+#ifdef FRACTION_POSIX
+	bool good = true;
+	std::vector<pid_t> pids;
+	for (iType r = 0; r < num && good; ++r) {
+		const pid_t pid = ::fork();
+		if (pid == 0) {
+			int code = 0;
+			try { task(r); }
+			catch (...) { code = 1; }
+			::_exit(code);
+		}
+		if (pid < 0) good = false;
+		else pids.push_back(pid);
+	}
+	for (const pid_t pid : pids) {
+		int status = 0;
+		const bool exited = ::waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+		good = good && exited;
+	}
+	return good;
+#else
+	try {
+		for (iType r = 0; r < num; ++r) task(r);
+	}
+	catch (...) {
+		return false;
+	}
+	return true;
+#endif
+}
+
+//memory shared with the processes of run_mc_processes (anonymous shared mapping, zero-initialized)
+class MCSharedMemory
+{
+public:
+	explicit MCSharedMemory(const std::size_t bytes) : bytes(std::max<std::size_t>(bytes, 1))
+	{
+#ifdef FRACTION_POSIX
+		void* p = ::mmap(nullptr, this->bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		data = p == MAP_FAILED ? nullptr : static_cast<unsigned char*>(p);
+#else
+		buffer.resize(this->bytes);
+		data = buffer.data();
+#endif
+	}
+
+	~MCSharedMemory()
+	{
+#ifdef FRACTION_POSIX
+		if (data) ::munmap(data, bytes);
+#endif
+	}
+
+	MCSharedMemory(const MCSharedMemory&) = delete;
+	MCSharedMemory& operator=(const MCSharedMemory&) = delete;
+
+	unsigned char* get() const { return data; }
+
+private:
+	std::size_t bytes;
+	unsigned char* data = nullptr;
+#ifndef FRACTION_POSIX
+	std::vector<unsigned char> buffer;
+#endif
+};
+
+//local driver of px * py * pz ranks on one machine. each rank computes its owned nodes with
+//fill(shard, owned) into shared memory (owned stored over shard.nodes). once all ranks are done,
+//each rank gathers its halo from the owned nodes of its neighbors, evaluates its cells, and writes
+//its result to shared memory, and the results are merged in rank order. returns false if a rank failed
+template<typename T, typename F>
+bool get_mc_shards_local(const iType nx, const iType ny, const iType nz, const iType px, const iType py, const iType pz,
+	F&& fill, MCShardResult& result)
+{
+	static_assert(std::is_trivially_copyable<MCShardResult>::value, "shard results are copied as bytes");
+	result = MCShardResult();
+	const iType num = px * py * pz;
+	if (num <= 0) return false;
+	std::vector<MCShard> shards(num);
+	std::vector<std::size_t> offset(num + 1, 0);
+	for (iType r = 0; r < num; ++r) {
+		shards[r] = get_mc_shard(nx, ny, nz, px, py, pz, r);
+		offset[r + 1] = offset[r] + get_mc_box_size(shards[r].nodes);
+	}
+	const std::size_t result_bytes = sizeof(MCShardResult) * num;
+	MCSharedMemory memory(result_bytes + sizeof(T) * offset[num]);
+	if (!memory.get()) return false;
+	unsigned char* results = memory.get();
+	T* nodes = reinterpret_cast<T*>(memory.get() + result_bytes);
+
+	if (!run_mc_processes(num, [&](const iType r) { fill(static_cast<const MCShard&>(shards[r]), nodes + offset[r]); })) return false;
+	const bool good = run_mc_processes(num, [&](const iType r) {
+		const MCBox b = get_mc_shard_block(shards[r]);
+		std::vector<T> block(get_mc_box_size(b));
+		for (iType s = 0; s < num; ++s) copy_mc_box_nodes(shards[s].nodes, nodes + offset[s], b, block.data());
+		const MCShardResult partial = get_mc_shard_result(block.data(), shards[r]);
+		std::memcpy(results + sizeof(MCShardResult) * r, &partial, sizeof(MCShardResult));
+	});
+	if (!good) return false;
+	std::vector<MCShardResult> partial(num);
+	std::memcpy(partial.data(), results, result_bytes);
+	result = get_mc_shard_sum(partial.data(), partial.size());
+	return true;
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+Copyright(c) 2021, Tetsuya Takahashi and Christopher Batty
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this softwareand associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright noticeand this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FRACTION_SIMD_HPP
+#define FRACTION_SIMD_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "fraction.hpp"
+
+//the instruction set is chosen at compile time (-mavx512f, -mavx2, or -march=native);
+//define FRACTION_NO_SIMD to force the scalar fallback
+#if !defined(FRACTION_NO_SIMD) && (defined(__AVX512F__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+namespace Fraction
+{
+
+//=================================================================================================
+//		mc-style batch
+//=================================================================================================
+
+//corner values of a batch of cells in structure-of-arrays form: v[c][i] is corner c of cell i.
+//the table indices and the 12 edge fractions of each cell are computed with vector compares and blends,
+//and only the case kernels of cells crossing the surface are evaluated per cell (through the S12 path)
+using SoA8 = std::array<const fType*, 8>;
+
+//lanes of fType per vector: 8 with AVX-512 and 4 with AVX2. the batch is double-only, so the 16 float lanes
+//of AVX-512 are not used
+#if !defined(FRACTION_NO_SIMD) && defined(__AVX512F__)
+constexpr iType mc_batch_width = 8;
+#elif !defined(FRACTION_NO_SIMD) && defined(__AVX2__)
+constexpr iType mc_batch_width = 4;
+#else
+constexpr iType mc_batch_width = 1;
+#endif
+
+//table indices and edge fractions of cells [i0, i0 + n), stored in idx[l] and e[edge][l].
+//the edge fractions are left unset for groups of cells that are all fully inside or outside
+template<iType N>
+struct MCBatch
+{
+	std::int64_t idx[N];
+	fType e[12][N];
+};
+
+constexpr iType mc_batch_chunk = 64;
+
+inline S8 get_mc_batch_cell(const SoA8& v, const std::size_t i)
+{
+	return { v[0][i], v[1][i], v[2][i], v[3][i], v[4][i], v[5][i], v[6][i], v[7][i] };
+}
+
+template<iType N>
+inline void get_mc_batch(const SoA8& v, const std::size_t i0, const iType n, MCBatch<N>& b)
+{
+	iType l = 0;
+#if !defined(FRACTION_NO_SIMD) && defined(__AVX512F__)
+	const __m512d zero = _mm512_setzero_pd(), one = _mm512_set1_pd(1.0);
+	for (; l + 8 <= n; l += 8) {
+		__m512d x[8];
+		__m512i idx = _mm512_setzero_si512();
+		for (iType c = 0; c < 8; ++c) {
+			x[c] = _mm512_loadu_pd(v[c] + i0 + l);
+			const __mmask8 m = _mm512_cmp_pd_mask(x[c], zero, _CMP_LT_OQ);
+			idx = _mm512_mask_or_epi64(idx, m, idx, _mm512_set1_epi64(std::int64_t(1) << c));
+		}
+		_mm512_storeu_si512(b.idx + l, idx);
+		const __mmask8 uniform = _mm512_cmpeq_epi64_mask(idx, _mm512_setzero_si512()) |
+			_mm512_cmpeq_epi64_mask(idx, _mm512_set1_epi64(255));
+		if (uniform == 0xff) continue;
+		for (iType k = 0; k < 12; ++k) {
+			//min/max by a blend on one compare: gcc 12 warns about the undefined pass-through operand of _mm512_min_pd/_mm512_max_pd
+			const __m512d x0 = x[mc_edges[k][0]], x1 = x[mc_edges[k][1]];
+			const __mmask8 less = _mm512_cmp_pd_mask(x0, x1, _CMP_LT_OQ);
+			const __m512d lo = _mm512_mask_blend_pd(less, x1, x0);
+			const __m512d hi = _mm512_mask_blend_pd(less, x0, x1);
+			const __m512d frac = _mm512_div_pd(lo, _mm512_sub_pd(lo, hi));
+			__m512d r = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(lo, zero, _CMP_LT_OQ), zero, frac);
+			r = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hi, zero, _CMP_LT_OQ), r, one);
+			_mm512_storeu_pd(b.e[k] + l, r);
+		}
+	}
+#elif !defined(FRACTION_NO_SIMD) && defined(__AVX2__)
+	const __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+	for (; l + 4 <= n; l += 4) {
+		__m256d x[8];
+		__m256i idx = _mm256_setzero_si256();
+		for (iType c = 0; c < 8; ++c) {
+			x[c] = _mm256_loadu_pd(v[c] + i0 + l);
+			const __m256i m = _mm256_castpd_si256(_mm256_cmp_pd(x[c], zero, _CMP_LT_OQ));
+			idx = _mm256_or_si256(idx, _mm256_and_si256(m, _mm256_set1_epi64x(std::int64_t(1) << c)));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(b.idx + l), idx);
+		const __m256i uniform = _mm256_or_si256(_mm256_cmpeq_epi64(idx, _mm256_setzero_si256()),
+			_mm256_cmpeq_epi64(idx, _mm256_set1_epi64x(255)));
+		if (_mm256_movemask_pd(_mm256_castsi256_pd(uniform)) == 0xf) continue;
+		for (iType k = 0; k < 12; ++k) {
+			const __m256d lo = _mm256_min_pd(x[mc_edges[k][0]], x[mc_edges[k][1]]);
+			const __m256d hi = _mm256_max_pd(x[mc_edges[k][0]], x[mc_edges[k][1]]);
+			const __m256d frac = _mm256_div_pd(lo, _mm256_sub_pd(lo, hi));
+			__m256d r = _mm256_blendv_pd(zero, frac, _mm256_cmp_pd(lo, zero, _CMP_LT_OQ));
+			r = _mm256_blendv_pd(r, one, _mm256_cmp_pd(hi, zero, _CMP_LT_OQ));
+			_mm256_storeu_pd(b.e[k] + l, r);
+		}
+	}
+#endif
+	for (; l < n; ++l) {
+		const S8 x = get_mc_batch_cell(v, i0 + l);
+		b.idx[l] = get_mc_table_index(x);
+		for (iType k = 0; k < 12; ++k) b.e[k][l] = get_len_frac(x[mc_edges[k][0]], x[mc_edges[k][1]]);
+	}
+}
+
+//calls f(i, table_index, e) for cells [0, n) of the batch
+template<typename F>
+void for_each_mc_batch_cell(const SoA8& v, const std::size_t n, F&& f)
+{
+	const S12 outside{};
+	S12 inside;
+	inside.fill(1.0);
+	MCBatch<mc_batch_chunk> b;
+	for (std::size_t i0 = 0; i0 < n; i0 += mc_batch_chunk) {
+		const iType m = iType(std::min<std::size_t>(mc_batch_chunk, n - i0));
+		get_mc_batch(v, i0, m, b);
+		for (iType l = 0; l < m; ++l) {
+			if (b.idx[l] == 0 || b.idx[l] == 255) {
+				f(i0 + l, iType(b.idx[l]), b.idx[l] == 0 ? outside : inside);
+				continue;
+			}
+			const S12 e{ b.e[0][l], b.e[1][l], b.e[2][l], b.e[3][l], b.e[4][l], b.e[5][l],
+				b.e[6][l], b.e[7][l], b.e[8][l], b.e[9][l], b.e[10][l], b.e[11][l] };
+			f(i0 + l, iType(b.idx[l]), e);
+		}
+	}
+}
+
+//out[i] = get_mc_vol of cell i
+inline void get_mc_vol_batch(const SoA8& v, const std::size_t n, fType* out)
+{
+	if constexpr (mc_batch_width == 1) {//the edge fractions are computed lazily by the kernels
+		for (std::size_t i = 0; i < n; ++i) out[i] = get_mc_vol(get_mc_batch_cell(v, i));
+		return;
+	}
+	for_each_mc_batch_cell(v, n, [out](const std::size_t i, const iType table_index, const S12& e) {
+		out[i] = table_index == 0 ? 0.0 : table_index == 255 ? 1.0 : get_mc_vol(table_index, e);
+	});
+}
+
+//out[i] = get_mc_area of cell i
+inline void get_mc_area_batch(const SoA8& v, const std::size_t n, fType* out)
+{
+	if constexpr (mc_batch_width == 1) {
+		for (std::size_t i = 0; i < n; ++i) out[i] = get_mc_area(get_mc_batch_cell(v, i));
+		return;
+	}
+	for_each_mc_batch_cell(v, n, [out](const std::size_t i, const iType table_index, const S12& e) {
+		out[i] = table_index == 0 || table_index == 255 ? 0.0 : get_mc_area(table_index, e);
+	});
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,205 @@
+/*
+Copyright(c) 2021, Tetsuya Takahashi and Christopher Batty
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this softwareand associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright noticeand this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FRACTION_SPARSE_HPP
+#define FRACTION_SPARSE_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "fraction_grid.hpp"
+
+namespace Fraction
+{
+
+//=================================================================================================
+//		sparse grid
+//=================================================================================================
+
+//a grid of nx * ny * nz nodes stored as bricks of mc_sparse_brick^3 nodes, where only the bricks
+//near the surface are allocated and all nodes of an unallocated brick have its tile value
+//(the background value unless set otherwise, e.g., negative for bricks inside a closed surface).
+//brick (bi, bj, bk) holds the nodes [8 bi, 8 bi + 8) x ... and is found through a dense map
+//of brick offsets, i.e., a two-level grid without hashing
+constexpr iType mc_sparse_brick = 8;
+
+template<typename T = fType>
+struct MCSparseGrid
+{
+	static constexpr std::size_t brick_nodes = std::size_t(mc_sparse_brick) * mc_sparse_brick * mc_sparse_brick;
+	static constexpr std::uint32_t unallocated = ~std::uint32_t(0);
+
+	iType nx = 0, ny = 0, nz = 0;
+	iType bx = 0, by = 0, bz = 0;//brick counts
+	T background = T(1.0);
+	std::vector<std::uint32_t> map;//offset / brick_nodes of brick bi + bx * (bj + by * bk) in data, or unallocated
+	std::vector<T> tile;//value of all nodes of brick bi + bx * (bj + by * bk) if it is unallocated
+	std::vector<T> data;//nodes of a brick stored as i + 8 * (j + 8 * k)
+
+	MCSparseGrid() = default;
+	MCSparseGrid(const iType nx, const iType ny, const iType nz, const T background) { build(nx, ny, nz, background); }
+
+	//all nodes have the background value after building
+	void build(const iType nx_, const iType ny_, const iType nz_, const T background_)
+	{
+		nx = nx_;
+		ny = ny_;
+		nz = nz_;
+		background = background_;
+		const auto count = [](const iType n) { return (n + mc_sparse_brick - 1) / mc_sparse_brick; };
+		bx = count(nx);
+		by = count(ny);
+		bz = count(nz);
+		map.assign(std::size_t(bx) * by * bz, unallocated);
+		tile.assign(map.size(), background);
+		data.clear();
+	}
+
+	std::size_t get_brick(const iType bi, const iType bj, const iType bk) const
+	{
+		return bi + std::size_t(bx) * (bj + std::size_t(by) * bk);
+	}
+
+	//nodes of brick b, or nullptr if it is not allocated
+	const T* get_brick_data(const std::size_t b) const
+	{
+		return map[b] == unallocated ? nullptr : data.data() + map[b] * brick_nodes;
+	}
+
+	//allocates brick b filled with its tile value, if it is not allocated yet
+	T* allocate(const std::size_t b)
+	{
+		if (map[b] == unallocated) {
+			map[b] = std::uint32_t(data.size() / brick_nodes);
+			data.resize(data.size() + brick_nodes, tile[b]);
+		}
+		return data.data() + map[b] * brick_nodes;
+	}
+
+	T get(const iType i, const iType j, const iType k) const
+	{
+		const std::size_t b = get_brick(i / mc_sparse_brick, j / mc_sparse_brick, k / mc_sparse_brick);
+		const T* p = get_brick_data(b);
+		return p ? p[get_offset(i, j, k)] : tile[b];
+	}
+
+	//allocates the brick of node (i, j, k) if needed
+	void set(const iType i, const iType j, const iType k, const T v)
+	{
+		allocate(get_brick(i / mc_sparse_brick, j / mc_sparse_brick, k / mc_sparse_brick))[get_offset(i, j, k)] = v;
+	}
+
+	//sets the value of all nodes of an unallocated brick
+	void set_tile(const iType bi, const iType bj, const iType bk, const T v)
+	{
+		tile[get_brick(bi, bj, bk)] = v;
+	}
+
+	static std::size_t get_offset(const iType i, const iType j, const iType k)
+	{
+		return i % mc_sparse_brick + std::size_t(mc_sparse_brick) * (j % mc_sparse_brick + std::size_t(mc_sparse_brick) * (k % mc_sparse_brick));
+	}
+};
+
+//the cells of brick b are [8 bi, 8 bi + 8) x ..., and their nodes also lie in the bricks b + 1 in each direction.
+//calls uniform(box, inside) for the bricks whose nodes are all inside or all outside
+//(without touching the nodes if they all lie in unallocated bricks with tiles of the same sign),
+//and mixed(phi, box) for the others, where phi is the dense 9^3 block of the nodes of the brick
+//gathered across the brick boundaries and box is the cells of the brick in the block.
+//the bricks are visited in a fixed order
+template<typename T, typename Uniform, typename Mixed>
+void for_each_mc_sparse_brick(const MCSparseGrid<T>& grid, Uniform&& uniform, Mixed&& mixed)
+{
+	constexpr iType s = mc_sparse_brick, n = mc_sparse_brick + 1;
+	std::vector<T> block(std::size_t(n) * n * n);
+	for (iType bk = 0; bk < grid.bz; ++bk) {
+		for (iType bj = 0; bj < grid.by; ++bj) {
+			for (iType bi = 0; bi < grid.bx; ++bi) {
+				const MCBox cells{ bi * s, bj * s, bk * s,
+					std::min(bi * s + s, grid.nx - 1), std::min(bj * s + s, grid.ny - 1), std::min(bk * s + s, grid.nz - 1) };
+				if (cells.i1 <= cells.i0 || cells.j1 <= cells.j0 || cells.k1 <= cells.k0) continue;
+
+				//the (up to) 8 bricks holding the nodes of the cells
+				std::array<const T*, 8> bricks{};
+				std::array<T, 8> tiles{};
+				iType num_allocated = 0, num_inside = 0, num_bricks = 0;
+				for (iType c = 0; c < 8; ++c) {
+					const iType ci = bi + (c & 1), cj = bj + ((c >> 1) & 1), ck = bk + (c >> 2);
+					if (ci >= grid.bx || cj >= grid.by || ck >= grid.bz) continue;
+					const std::size_t b = grid.get_brick(ci, cj, ck);
+					bricks[c] = grid.get_brick_data(b);
+					tiles[c] = grid.tile[b];
+					++num_bricks;
+					num_allocated += bricks[c] != nullptr;
+					num_inside += tiles[c] < iso_value;
+				}
+				if (num_allocated == 0 && (num_inside == 0 || num_inside == num_bricks)) { uniform(cells, num_inside > 0); continue; }
+
+				const iType sx = cells.i1 - cells.i0 + 1, sy = cells.j1 - cells.j0 + 1, sz = cells.k1 - cells.k0 + 1;
+				bool inside = true, outside = true;
+				for (iType k = 0; k < sz; ++k) {
+					for (iType j = 0; j < sy; ++j) {
+						for (iType i = 0; i < sx; ++i) {
+							const iType c = (i / s) | ((j / s) << 1) | ((k / s) << 2);
+							const T v = bricks[c] ? bricks[c][MCSparseGrid<T>::get_offset(i, j, k)] : tiles[c];
+							block[i + std::size_t(n) * (j + std::size_t(n) * k)] = v;
+							inside &= v < iso_value;
+							outside &= !(v < iso_value);
+						}
+					}
+				}
+				if (inside || outside) uniform(cells, inside);
+				else mixed(block.data(), MCBox{ 0, 0, 0, sx - 1, sy - 1, sz - 1 });
+			}
+		}
+	}
+}
+
+template<typename T, typename A = T>
+A get_mc_vol_grid(const MCSparseGrid<T>& grid)
+{
+	constexpr iType n = mc_sparse_brick + 1;
+	A vol = 0.0;
+	for_each_mc_sparse_brick(grid,
+		[&vol](const MCBox& box, const bool inside) { if (inside) vol += A(box.i1 - box.i0) * A(box.j1 - box.j0) * A(box.k1 - box.k0); },
+		[&vol](const T* phi, const MCBox& box) { vol += get_mc_vol_grid<T, A>(phi, n, n, box); });
+	return vol;
+}
+
+template<typename T, typename A = T>
+A get_mc_area_grid(const MCSparseGrid<T>& grid)
+{
+	constexpr iType n = mc_sparse_brick + 1;
+	A area = 0.0;
+	for_each_mc_sparse_brick(grid,
+		[](const MCBox&, bool) {},
+		[&area](const T* phi, const MCBox& box) { area += get_mc_area_grid<T, A>(phi, n, n, box); });
+	return area;
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+}
+
+#endif
@@ -0,0 +1,197 @@
+/*
+Copyright(c) 2021, Tetsuya Takahashi and Christopher Batty
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this softwareand associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright noticeand this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef FRACTION_STREAM_HPP
+#define FRACTION_STREAM_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "fraction_grid.hpp"
+
+//POSIX systems read with pread and posix_fadvise hints; define FRACTION_NO_POSIX to use std::ifstream instead
+#if !defined(FRACTION_NO_POSIX) && (defined(__unix__) || defined(__APPLE__))
+#define FRACTION_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace Fraction
+{
+
+//=================================================================================================
+//		streaming grid
+//=================================================================================================
+
+//a raw volume file of nx * ny * nz nodes of type T, stored as in get_mc_vol_grid (i fastest).
+//node (0, 0, k) is at the byte offset + slice_stride * k, so that a header and padding between
+//the z-slices can be skipped (slice_stride = 0: the slices are packed, nx * ny * sizeof(T) apart)
+struct MCRawFile
+{
+	std::string path;
+	iType nx = 0, ny = 0, nz = 0;
+	std::uint64_t offset = 0;
+	std::uint64_t slice_stride = 0;
+};
+
+struct MCStreamStats
+{
+	std::uint64_t bytes_read = 0;
+	double seconds = 0.0;
+
+	double get_throughput() const { return seconds > 0.0 ? double(bytes_read) / seconds : 0.0; }//bytes per second
+};
+
+//reads the z-slices of a raw file in increasing order into two buffers, so that only two slices are
+//resident. the kernel is told that the file is read sequentially, the next slice is prefetched,
+//and the slices already read are dropped from the page cache
+template<typename T>
+class MCSliceReader
+{
+public:
+	explicit MCSliceReader(const MCRawFile& file) : file(file), slice_bytes(std::uint64_t(file.nx) * file.ny * sizeof(T))
+	{
+		if (this->file.slice_stride == 0) this->file.slice_stride = slice_bytes;
+		for (std::vector<T>& b : buffers) b.resize(std::size_t(file.nx) * file.ny);
+#ifdef FRACTION_POSIX
+		fd = ::open(file.path.c_str(), O_RDONLY);
+		good = fd >= 0;
+#ifdef POSIX_FADV_SEQUENTIAL
+		if (fd >= 0) ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+		stream.open(file.path, std::ios::binary);
+		good = stream.is_open();
+#endif
+	}
+
+	~MCSliceReader()
+	{
+#ifdef FRACTION_POSIX
+		if (fd >= 0) ::close(fd);
+#endif
+	}
+
+	MCSliceReader(const MCSliceReader&) = delete;
+	MCSliceReader& operator=(const MCSliceReader&) = delete;
+
+	//false if the file could not be opened or a slice could not be read
+	bool is_good() const { return good; }
+
+	std::uint64_t get_bytes_read() const { return bytes_read; }
+
+	//slice k in the buffer not holding slice k - 1, or nullptr once the file could not be opened or a slice could not be read
+	const T* get_slice(const iType k)
+	{
+		T* p = buffers[k & 1].data();
+		const std::uint64_t pos = file.offset + file.slice_stride * std::uint64_t(k);
+		good = good && read(pos, reinterpret_cast<char*>(p));
+		if (!good) return nullptr;
+		bytes_read += slice_bytes;
+#if defined(FRACTION_POSIX) && defined(POSIX_FADV_WILLNEED)
+		if (good && k + 1 < file.nz) ::posix_fadvise(fd, off_t(pos + file.slice_stride), off_t(slice_bytes), POSIX_FADV_WILLNEED);
+		if (good && k > 0) ::posix_fadvise(fd, off_t(pos - file.slice_stride), off_t(slice_bytes), POSIX_FADV_DONTNEED);
+#endif
+		return p;
+	}
+
+private:
+	MCRawFile file;
+	std::uint64_t slice_bytes;
+	std::uint64_t bytes_read = 0;
+	std::vector<T> buffers[2];
+#ifdef FRACTION_POSIX
+	int fd = -1;
+	bool good = true;
+
+	bool read(std::uint64_t pos, char* p)
+	{
+		for (std::uint64_t n = slice_bytes; n > 0;) {
+			const ssize_t r = ::pread(fd, p, std::size_t(n), off_t(pos));
+			if (r <= 0) return false;
+			p += r;
+			pos += std::uint64_t(r);
+			n -= std::uint64_t(r);
+		}
+		return true;
+	}
+#else
+	std::ifstream stream;
+	bool good = true;
+
+	bool read(const std::uint64_t pos, char* p)
+	{
+		stream.seekg(std::streamoff(pos));
+		stream.read(p, std::streamsize(slice_bytes));
+		return bool(stream);
+	}
+#endif
+};
+
+//volume and area of a raw file in one pass over its z-slices, with the memory of two slices and the
+//rolling edge buffers of get_mc_vol_grid (independent of nz). the result equals get_mc_vol_grid/get_mc_area_grid
+//of the whole array loaded into memory. returns false if the file could not be opened or is too short;
+//the walk stops at the first slice that cannot be read
+template<typename T, typename A = T>
+bool get_mc_grid_stream(const MCRawFile& file, A& vol, A& area, MCStreamStats* stats = nullptr)
+{
+	const auto start = std::chrono::steady_clock::now();
+	MCSliceReader<T> reader(file);
+	vol = area = A(0.0);
+	A v = 0.0, a = 0.0;
+	const auto f = [&](iType, iType, iType, const iType table_index, const std::array<T, 12>& e) {
+		if (table_index == 0) return;
+		if (table_index == 255) { v += A(1.0); return; }
+		v += A(get_mc_vol(table_index, e));
+		a += A(get_mc_area(table_index, e));
+	};
+	const MCBox box{ 0, 0, 0, file.nx - 1, file.ny - 1, file.nz - 1 };
+	MCWalker<T> walker;
+	const T* slice = box.i1 >= 1 && box.j1 >= 1 && box.k1 >= 1 ? reader.get_slice(0) : nullptr;
+	if (slice && walker.begin(slice, file.nx, box)) {
+		for (iType k = 0; k < box.k1; ++k) {
+			slice = reader.get_slice(k + 1);
+			if (!slice) break;
+			walker.step(k, slice, f);
+		}
+	}
+	if (stats) {
+		stats->bytes_read = reader.get_bytes_read();
+		stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	if (!reader.is_good()) return false;
+	vol = v;
+	area = a;
+	return true;
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+}
+
+#endif
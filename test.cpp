@@ -0,0 +1,1048 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "fraction_grid.hpp"
+#include "fraction_octree.hpp"
+#include "fraction_shard.hpp"
+#include "fraction_simd.hpp"
+#include "fraction_sparse.hpp"
+#include "fraction_stream.hpp"
+#include "test_reference.hpp"
+
+//equivalence checks of the grid evaluators against the per-cell kernels and against each other.
+//usage: fraction_test [name]; runs the test with the given name (all tests by default),
+//and the exit code is 1 if a check fails
+
+using namespace Fraction;
+
+int num_failed = 0;
+
+void check(const std::string& what, const bool ok)
+{
+	if (ok) return;
+	std::printf("FAILED %s\n", what.c_str());
+	++num_failed;
+}
+
+//relative to the magnitude of the values, with 1 as the smallest magnitude
+void check_near(const std::string& what, const double a, const double b, const double tol = 1e-10)
+{
+	if (std::abs(a - b) <= tol * std::max({ 1.0, std::abs(a), std::abs(b) })) return;
+	std::printf("FAILED %s: %.17g != %.17g\n", what.c_str(), a, b);
+	++num_failed;
+}
+
+//=================================================================================================
+//		test grids
+//=================================================================================================
+
+//phi[i + nx * (j + ny * k)] with unequal sides, so that swapped strides are caught,
+//and more than mc_brick_size cells along some axes, so that the grids span several bricks
+struct TestGrid
+{
+	std::string name;
+	iType nx, ny, nz;
+	std::vector<fType> phi;
+
+	fType at(const iType i, const iType j, const iType k) const { return phi[i + std::size_t(nx) * (j + std::size_t(ny) * k)]; }
+
+	S8 get_cell(const iType i, const iType j, const iType k) const
+	{
+		return { at(i, j, k), at(i + 1, j, k), at(i + 1, j + 1, k), at(i, j + 1, k),
+			at(i, j, k + 1), at(i + 1, j, k + 1), at(i + 1, j + 1, k + 1), at(i, j + 1, k + 1) };
+	}
+};
+
+TestGrid make_test_grid(const std::string& name, const iType nx, const iType ny, const iType nz, const std::function<fType(fType, fType, fType)>& f)
+{
+	TestGrid g{ name, nx, ny, nz, std::vector<fType>(std::size_t(nx) * ny * nz) };
+	for (iType k = 0; k < nz; ++k)
+		for (iType j = 0; j < ny; ++j)
+			for (iType i = 0; i < nx; ++i) g.phi[i + std::size_t(nx) * (j + std::size_t(ny) * k)] = f(fType(i), fType(j), fType(k));
+	return g;
+}
+
+std::vector<TestGrid> make_test_grids()
+{
+	const auto length = [](fType x, fType y, fType z) { return std::sqrt(x * x + y * y + z * z); };
+	return {
+		make_test_grid("sphere", 37, 41, 35, [=](fType x, fType y, fType z) { return length(x - 18.3, y - 20.1, z - 17.2) - 13.7; }),
+		//most cells are mixed and all table indices occur
+		make_test_grid("noise", 29, 43, 31, [](fType x, fType y, fType z) {
+			return std::sin(1.7 * x + 0.3 * y) * std::cos(1.3 * z + 0.7 * x) + 0.5 * std::sin(1.1 * y - 0.9 * z);
+		}),
+		//values on a coarse lattice, so that many nodes lie exactly on the iso value
+		make_test_grid("quantized", 45, 27, 38, [=](fType x, fType y, fType z) {
+			return std::round(4.0 * (length(x - 22.0, y - 13.0, z - 19.0) - 11.0)) / 4.0;
+		}),
+	};
+}
+
+//num random cells with the corner signs of each of the 256 table indices
+std::vector<S8> make_table_index_cells(const iType num = 16)
+{
+	std::vector<S8> cells;
+	std::uint64_t seed = 1;
+	for (iType table_index = 0; table_index < 256; ++table_index) {
+		for (iType n = 0; n < num; ++n) {
+			S8 v;
+			for (iType c = 0; c < 8; ++c) {
+				seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+				const fType r = fType((seed >> 11) + 1) / fType(1ULL << 53);
+				v[c] = (table_index >> c & 1) ? -r : r;
+			}
+			cells.push_back(v);
+		}
+	}
+	return cells;
+}
+
+//sum of f(v) over the cells of a grid, in the order of the grid walk
+template<typename F>
+double sum_test_cells(const TestGrid& g, F&& f)
+{
+	double sum = 0.0;
+	for (iType k = 0; k + 1 < g.nz; ++k)
+		for (iType j = 0; j + 1 < g.ny; ++j)
+			for (iType i = 0; i + 1 < g.nx; ++i) sum += f(g.get_cell(i, j, k));
+	return sum;
+}
+
+//the welded mesh of get_mc_vol_area_grid, in buffers sized by a first call
+struct TestMesh
+{
+	std::vector<fType> vertices;
+	std::vector<std::uint32_t> triangles;
+	fType vol = 0.0, area = 0.0;
+};
+
+TestMesh make_test_mesh(const TestGrid& g)
+{
+	TestMesh m;
+	MCMesh<fType> mesh;
+	get_mc_vol_area_grid(g.phi.data(), g.nx, g.ny, g.nz, m.vol, m.area, &mesh);
+	m.vertices.resize(3 * mesh.num_vertices);
+	m.triangles.resize(3 * mesh.num_triangles);
+	mesh = { m.vertices.data(), m.triangles.data(), mesh.num_vertices, mesh.num_triangles };
+	get_mc_vol_area_grid(g.phi.data(), g.nx, g.ny, g.nz, m.vol, m.area, &mesh);
+	return m;
+}
+
+//sum of the triangle areas with the vertices scaled by (dx, dy, dz)
+double get_test_mesh_area(const TestMesh& m, const std::array<double, 3>& d = { 1.0, 1.0, 1.0 })
+{
+	double area = 0.0;
+	for (std::size_t t = 0; t < m.triangles.size(); t += 3) {
+		std::array<std::array<double, 3>, 3> p;
+		for (iType l = 0; l < 3; ++l)
+			for (iType a = 0; a < 3; ++a) p[l][a] = d[a] * m.vertices[3 * std::size_t(m.triangles[t + l]) + a];
+		std::array<double, 3> u, v;
+		for (iType a = 0; a < 3; ++a) {
+			u[a] = p[1][a] - p[0][a];
+			v[a] = p[2][a] - p[0][a];
+		}
+		const double x = u[1] * v[2] - u[2] * v[1], y = u[2] * v[0] - u[0] * v[2], z = u[0] * v[1] - u[1] * v[0];
+		area += 0.5 * std::sqrt(x * x + y * y + z * z);
+	}
+	return area;
+}
+
+//=================================================================================================
+//		tests
+//=================================================================================================
+
+//get_mc_vol_grid/get_mc_area_grid: each cell of the walk matches the kernels on its corner values bitwise,
+//and the totals match the per-cell sums
+void test_grid()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		bool same = true;
+		for_each_mc_cell(g.phi.data(), g.nx, g.ny, g.nz, [&](const iType i, const iType j, const iType k, const iType table_index, const S12& e) {
+			const S8 v = g.get_cell(i, j, k);
+			same = same && table_index == get_mc_table_index(v);
+			if (table_index == 0 || table_index == 255) return;
+			same = same && get_mc_vol(table_index, e) == get_mc_vol(v) && get_mc_area(table_index, e) == get_mc_area(v);
+		});
+		check("grid cells bitwise " + g.name, same);
+		check_near("grid vol " + g.name, get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz), sum_test_cells(g, [](const S8& v) { return get_mc_vol(v); }));
+		check_near("grid area " + g.name, get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz), sum_test_cells(g, [](const S8& v) { return get_mc_area(v); }));
+	}
+}
+
+//get_mc_vol_grid_parallel/get_mc_area_grid_parallel: bitwise identical for any number of threads,
+//and equal to the serial functions up to rounding
+void test_parallel()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		const double vol = get_mc_vol_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 1 });
+		const double area = get_mc_area_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 1 });
+		for (const iType num_threads : { 2, 3, 7 }) {
+			check("parallel vol bitwise " + g.name, get_mc_vol_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ num_threads }) == vol);
+			check("parallel area bitwise " + g.name, get_mc_area_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ num_threads }) == area);
+		}
+		check_near("parallel vol " + g.name, vol, get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("parallel area " + g.name, area, get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+	}
+}
+
+//get_mc_vol_batch/get_mc_area_batch match the kernels on the edge fractions of each cell bitwise,
+//and on its corner values up to the rounding of the multiply-adds that -mfma contracts.
+//the vectorized front end is compiled by the -mavx2/-mavx512f builds of this test and skipped on machines without it
+void test_simd()
+{
+#if defined(__GNUC__) && !defined(FRACTION_NO_SIMD) && defined(__AVX512F__)
+	if (!__builtin_cpu_supports("avx512f")) { std::printf("avx512f not supported, skipped\n"); return; }
+#elif defined(__GNUC__) && !defined(FRACTION_NO_SIMD) && defined(__AVX2__)
+	if (!__builtin_cpu_supports("avx2")) { std::printf("avx2 not supported, skipped\n"); return; }
+#endif
+	for (const TestGrid& g : make_test_grids()) {
+		std::array<std::vector<fType>, 8> soa;
+		for (iType k = 0; k + 1 < g.nz; ++k)
+			for (iType j = 0; j + 1 < g.ny; ++j)
+				for (iType i = 0; i + 1 < g.nx; ++i) {
+					const S8 v = g.get_cell(i, j, k);
+					for (iType c = 0; c < 8; ++c) soa[c].push_back(v[c]);
+				}
+		const SoA8 cells{ soa[0].data(), soa[1].data(), soa[2].data(), soa[3].data(), soa[4].data(), soa[5].data(), soa[6].data(), soa[7].data() };
+		//an odd count, so that the scalar tail of the last chunk is used
+		const std::size_t n = soa[0].size() - 3;
+		std::vector<fType> vol(n), area(n);
+		get_mc_vol_batch(cells, n, vol.data());
+		get_mc_area_batch(cells, n, area.data());
+		bool same = true;
+		double error = 0.0;
+		for (std::size_t i = 0; i < n; ++i) {
+			const S8 v = get_mc_batch_cell(cells, i);
+			const iType table_index = get_mc_table_index(v);
+			S12 e;
+			for (iType k = 0; k < 12; ++k) e[k] = get_len_frac(v[mc_edges[k][0]], v[mc_edges[k][1]]);
+			if (table_index != 0 && table_index != 255) same = same && vol[i] == get_mc_vol(table_index, e) && area[i] == get_mc_area(table_index, e);
+			error = std::max({ error, std::abs(vol[i] - get_mc_vol(v)), std::abs(area[i] - get_mc_area(v)) });
+		}
+		check("batch bitwise (width " + std::to_string(mc_batch_width) + ") " + g.name, same);
+		check_near("batch vs corner values " + g.name, error, 0.0, 1e-12);
+	}
+}
+
+//get_mc_vol_grid_binned/get_mc_area_grid_binned: the same cells as the walk, summed per table index
+void test_binned()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		check_near("binned vol " + g.name, get_mc_vol_grid_binned(g.phi.data(), g.nx, g.ny, g.nz), get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("binned area " + g.name, get_mc_area_grid_binned(g.phi.data(), g.nx, g.ny, g.nz), get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+	}
+}
+
+//get_mc_vol_grid/get_mc_area_grid on an MCPyramid: equal to the walk up to rounding, also after phi
+//has changed in a box and the pyramid was updated there, where the bricks match a rebuilt pyramid
+void test_pyramid()
+{
+	for (TestGrid g : make_test_grids()) {
+		MCPyramid<fType> pyramid(g.phi.data(), g.nx, g.ny, g.nz);
+		check_near("pyramid vol " + g.name, get_mc_vol_grid(pyramid, g.phi.data()), get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("pyramid area " + g.name, get_mc_area_grid(pyramid, g.phi.data()), get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+
+		const MCBox nodes{ 5, 9, 3, 21, 17, 12 };
+		for (iType k = nodes.k0; k < nodes.k1; ++k)
+			for (iType j = nodes.j0; j < nodes.j1; ++j)
+				for (iType i = nodes.i0; i < nodes.i1; ++i) g.phi[i + std::size_t(g.nx) * (j + std::size_t(g.ny) * k)] = fType(i % 3) - 1.0;
+		pyramid.update(g.phi.data(), nodes);
+		const MCPyramid<fType> rebuilt(g.phi.data(), g.nx, g.ny, g.nz);
+		bool same = pyramid.levels.size() == rebuilt.levels.size();
+		for (std::size_t l = 0; same && l < rebuilt.levels.size(); ++l)
+			same = pyramid.levels[l].lo == rebuilt.levels[l].lo && pyramid.levels[l].hi == rebuilt.levels[l].hi;
+		check("pyramid update " + g.name, same);
+		check_near("pyramid updated vol " + g.name, get_mc_vol_grid(pyramid, g.phi.data()), get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("pyramid updated area " + g.name, get_mc_area_grid(pyramid, g.phi.data()), get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+	}
+}
+
+//float grids: each cell of the walk matches the float kernels bitwise, and the totals with a double
+//accumulator match the double evaluation of the same node values up to the float accuracy of the kernels
+void test_float()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		const std::vector<float> phi(g.phi.begin(), g.phi.end());
+		TestGrid d = g;
+		d.phi.assign(phi.begin(), phi.end());
+		bool same = true;
+		for_each_mc_cell(phi.data(), g.nx, g.ny, g.nz, [&](const iType i, const iType j, const iType k, const iType table_index, const std::array<float, 12>& e) {
+			const S8 c = d.get_cell(i, j, k);
+			std::array<float, 8> v;
+			for (iType n = 0; n < 8; ++n) v[n] = float(c[n]);
+			same = same && table_index == get_mc_table_index(v);
+			if (table_index == 0 || table_index == 255) return;
+			same = same && get_mc_vol(table_index, e) == get_mc_vol(v) && get_mc_area(table_index, e) == get_mc_area(v);
+		});
+		check("float cells bitwise " + g.name, same);
+		check_near("float vol " + g.name, get_mc_vol_grid<float, double>(phi.data(), g.nx, g.ny, g.nz), get_mc_vol_grid(d.phi.data(), d.nx, d.ny, d.nz), 1e-6);
+		check_near("float area " + g.name, get_mc_area_grid<float, double>(phi.data(), g.nx, g.ny, g.nz), get_mc_area_grid(d.phi.data(), d.nx, d.ny, d.nz), 1e-5);
+		check_near("float parallel vol " + g.name, get_mc_vol_grid_parallel(phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 3 }), get_mc_vol_grid(d.phi.data(), d.nx, d.ny, d.nz), 1e-5);
+	}
+}
+
+//ScalarBackend: matches EigenBackend bitwise in double (up to rounding when multiply-adds are contracted into FMAs),
+//on each cell of the test grids and on random cells with the corner signs of each of the 256 table indices
+void test_backend()
+{
+#ifndef FRACTION_NO_EIGEN
+	std::vector<std::pair<std::string, std::vector<S8>>> sets;
+	for (const TestGrid& g : make_test_grids()) {
+		std::vector<S8> cells;
+		sum_test_cells(g, [&](const S8& v) { cells.push_back(v); return 0.0; });
+		sets.emplace_back(g.name, std::move(cells));
+	}
+	sets.emplace_back("table indices", make_table_index_cells());
+
+	for (const auto& set : sets) {
+		bool same = true;
+		double error = 0.0;
+		for (const S8& v : set.second) {
+			const fType vol = get_mc_vol<ScalarBackend>(v), area = get_mc_area<ScalarBackend>(v);
+			same = same && vol == get_mc_vol<EigenBackend>(v) && area == get_mc_area<EigenBackend>(v);
+			error = std::max({ error, std::abs(vol - get_mc_vol<EigenBackend>(v)), std::abs(area - get_mc_area<EigenBackend>(v)) });
+		}
+#ifdef __FMA__
+		check_near("backend " + set.first, error, 0.0, 1e-12);
+#else
+		check("backend bitwise " + set.first, same);
+#endif
+	}
+#else
+	std::printf("compiled without Eigen, skipped\n");
+#endif
+}
+
+//get_mc_stats: after a parallel grid pass, the merged counters of all threads equal the number of
+//mixed cells of each table index, and reset_mc_stats clears them. compiled by the FRACTION_STATS build of this test
+void test_stats()
+{
+#ifdef FRACTION_STATS
+	for (const TestGrid& g : make_test_grids()) {
+		std::array<std::uint64_t, 256> count{};
+		for_each_mc_cell(g.phi.data(), g.nx, g.ny, g.nz, [&count](iType, iType, iType, const iType table_index, const S12&) {
+			if (table_index != 0 && table_index != 255) ++count[table_index];
+		});
+		reset_mc_stats();
+		get_mc_vol_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 3 });
+		get_mc_area_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 3 });
+		const MCStats stats = get_mc_stats();
+		check("stats vol counts " + g.name, stats.vol.count == count);
+		check("stats area counts " + g.name, stats.area.count == count);
+		reset_mc_stats();
+		const MCStats reset = get_mc_stats();
+		check("stats reset " + g.name, reset.vol.count == std::array<std::uint64_t, 256>{} && reset.area.count == std::array<std::uint64_t, 256>{});
+	}
+#else
+	std::printf("compiled without FRACTION_STATS, skipped\n");
+#endif
+}
+
+//get_mc_case_compact (the default dispatch) and get_mc_case_switch (FRACTION_MC_SWITCH) match bitwise
+//for every table index, on corner values and on edge fractions, also with anisotropic area weights,
+//and both match the results of the hand-written case table (mc_reference_results) for every table index
+void test_dispatch()
+{
+	const std::vector<S8> reference_cells = make_table_index_cells(2);
+	for (std::size_t n = 0; n < reference_cells.size(); ++n) {
+		const S8& v = reference_cells[n];
+		const iType i = get_mc_table_index(v);
+		if (i == 0 || i == 255) continue;
+		const double* r = mc_reference_results[i][n % 2];
+		const std::string what = "dispatch reference table index " + std::to_string(i);
+		check_near(what + " vol compact", get_mc_case_compact<true, MCBackend>(i, v), r[0], 1e-13);
+		check_near(what + " area compact", get_mc_case_compact<false, MCBackend>(i, v), r[1], 1e-13);
+		check_near(what + " vol switch", get_mc_case_switch<true, MCBackend>(i, v), r[0], 1e-13);
+		check_near(what + " area switch", get_mc_case_switch<false, MCBackend>(i, v), r[1], 1e-13);
+	}
+
+	std::vector<S8> cells = make_table_index_cells();
+	for (const TestGrid& g : make_test_grids()) sum_test_cells(g, [&cells](const S8& v) { cells.push_back(v); return 0.0; });
+	const MCAreaWeights<fType> w{ 2.5, 1.0, 0.625 };
+	bool same = true;
+	for (const S8& v : cells) {
+		const iType i = get_mc_table_index(v);
+		S12 e;
+		for (iType k = 0; k < 12; ++k) e[k] = get_len_frac(v[mc_edges[k][0]], v[mc_edges[k][1]]);
+		same = same && get_mc_case_compact<true, MCBackend>(i, v) == get_mc_case_switch<true, MCBackend>(i, v);
+		same = same && get_mc_case_compact<false, MCBackend>(i, v) == get_mc_case_switch<false, MCBackend>(i, v);
+		same = same && get_mc_case_compact<true, MCBackend>(i, e) == get_mc_case_switch<true, MCBackend>(i, e);
+		same = same && get_mc_case_compact<false, MCBackend>(i, e) == get_mc_case_switch<false, MCBackend>(i, e);
+		same = same && get_mc_case_compact<false, MCBackend>(i, e, w) == get_mc_case_switch<false, MCBackend>(i, e, w);
+	}
+	check("dispatch compact vs switch bitwise", same);
+}
+
+//get_mc_measures: the volume of each cell matches get_mc_vol bitwise.
+//get_mc_measures_grid: the volume and area match the grid functions, the moments of the half-spaces
+//x_a < d (boxes) match their integrals exactly, since the surface of a linear field is exact,
+//and get_mc_measures_grid_parallel is bitwise identical for any number of threads and matches the serial function up to rounding
+void test_measures()
+{
+	bool same = true;
+	for (const S8& v : make_table_index_cells()) same = same && get_mc_measures(v).vol == get_mc_vol(v);
+	check("measures cell vol bitwise", same);
+	for (const TestGrid& g : make_test_grids()) {
+		const MCMeasures<double> m = get_mc_measures_grid(g.phi.data(), g.nx, g.ny, g.nz);
+		check_near("measures vol " + g.name, m.vol, get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("measures area " + g.name, m.area, get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		const MCMeasures<double> p = get_mc_measures_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 1 });
+		const MCMeasures<double> q = get_mc_measures_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, ThreadExecutor{ 3 });
+		check("measures parallel bitwise " + g.name, p.vol == q.vol && p.area == q.area && p.moment == q.moment && p.second_moment == q.second_moment);
+		check_near("measures parallel vol " + g.name, p.vol, m.vol);
+		for (iType a = 0; a < 3; ++a) {
+			check_near("measures parallel moment " + g.name, p.moment[a], m.moment[a]);
+			for (iType b = 0; b < 3; ++b) check_near("measures parallel second moment " + g.name, p.second_moment[a][b], m.second_moment[a][b]);
+		}
+	}
+
+	const std::array<iType, 3> n{ 23, 19, 27 };
+	const std::array<double, 3> l{ double(n[0] - 1), double(n[1] - 1), double(n[2] - 1) };
+	const double d = 7.3;
+	for (iType a = 0; a < 3; ++a) {
+		const TestGrid g = make_test_grid("half-space", n[0], n[1], n[2], [=](fType x, fType y, fType z) { return std::array<fType, 3>{ x, y, z }[a] - d; });
+		const MCMeasures<double> m = get_mc_measures_grid(g.phi.data(), g.nx, g.ny, g.nz);
+		//extents of the half-space and integrals of x_b and x_b^2 along each axis
+		std::array<double, 3> len = l, i1{}, i2{};
+		len[a] = d;
+		for (iType b = 0; b < 3; ++b) {
+			i1[b] = len[b] * len[b] / 2.0;
+			i2[b] = len[b] * len[b] * len[b] / 3.0;
+		}
+		const std::string what = "measures half-space " + std::to_string(a);
+		const double vol = len[0] * len[1] * len[2];
+		check_near(what + " vol", m.vol, vol);
+		check_near(what + " area", m.area, vol / len[a]);
+		const std::array<double, 3> centroid = get_mc_centroid(m);
+		const std::array<std::array<double, 3>, 3> inertia = get_mc_inertia(m);
+		for (iType b = 0; b < 3; ++b) {
+			check_near(what + " moment", m.moment[b], vol / len[b] * i1[b]);
+			check_near(what + " centroid", centroid[b], len[b] / 2.0);
+			for (iType c = 0; c < 3; ++c) {
+				const double expected = b == c ? vol / len[b] * i2[b] : vol / (len[b] * len[c]) * i1[b] * i1[c];
+				check_near(what + " second moment", m.second_moment[b][c], expected);
+				//of a box about its center, relative to the diagonal, since the off-diagonal terms cancel
+				const double scale = vol * (len[0] * len[0] + len[1] * len[1] + len[2] * len[2]);
+				const double box = b == c ? vol * (len[0] * len[0] + len[1] * len[1] + len[2] * len[2] - len[b] * len[b]) / 12.0 : 0.0;
+				check_near(what + " inertia", inertia[b][c] / scale, box / scale);
+			}
+		}
+	}
+}
+
+//MCTracker: the totals are bitwise identical to get_mc_vol_grid_parallel/get_mc_area_grid_parallel of the
+//current phi after building, after changing a box of nodes, and after changing a node on a brick boundary,
+//which marks the bricks on both sides of it
+void test_tracker()
+{
+	for (TestGrid g : make_test_grids()) {
+		const auto same = [&g](MCTracker<fType>& tracker, const iType num_threads) {
+			return tracker.get_vol(g.phi.data(), ThreadExecutor{ num_threads }) == get_mc_vol_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz) &&
+				tracker.get_area(g.phi.data(), ThreadExecutor{ num_threads }) == get_mc_area_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz);
+		};
+		MCTracker<fType> tracker(g.nx, g.ny, g.nz);
+		check("tracker built " + g.name, same(tracker, 3));
+
+		const MCBox nodes{ 5, 9, 3, 21, 17, 12 };
+		for (iType k = nodes.k0; k < nodes.k1; ++k)
+			for (iType j = nodes.j0; j < nodes.j1; ++j)
+				for (iType i = nodes.i0; i < nodes.i1; ++i) g.phi[i + std::size_t(g.nx) * (j + std::size_t(g.ny) * k)] = fType(i % 3) - 1.0;
+		tracker.mark(nodes);
+		check("tracker box " + g.name, same(tracker, 2));
+
+		if (g.nx <= mc_brick_size + 1) continue;
+		g.phi[mc_brick_size + std::size_t(g.nx) * (4 + std::size_t(g.ny) * 4)] = -0.25;
+		tracker.mark(mc_brick_size, 4, 4);
+		check("tracker brick boundary marks " + g.name, tracker.dirty_bricks.size() == 2);
+		check("tracker brick boundary " + g.name, same(tracker, 1));
+	}
+}
+
+//MCSparseGrid: a narrow band of allocated bricks with inside and outside tiles elsewhere gives the totals
+//of the dense grid of the same node values (get) up to rounding, as does a grid with all bricks allocated
+void test_sparse()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		const fType band = 3.0;
+		for (const bool narrow : { true, false }) {
+			MCSparseGrid<fType> grid(g.nx, g.ny, g.nz, band);
+			for (iType k = 0; k < g.nz; ++k) {
+				for (iType j = 0; j < g.ny; ++j) {
+					for (iType i = 0; i < g.nx; ++i) {
+						const fType v = g.at(i, j, k);
+						if (!narrow || std::abs(v) < band) grid.set(i, j, k, v);
+						else if (v < 0.0) grid.set_tile(i / mc_sparse_brick, j / mc_sparse_brick, k / mc_sparse_brick, -band);
+					}
+				}
+			}
+			TestGrid dense = g;
+			for (iType k = 0; k < g.nz; ++k)
+				for (iType j = 0; j < g.ny; ++j)
+					for (iType i = 0; i < g.nx; ++i) dense.phi[i + std::size_t(g.nx) * (j + std::size_t(g.ny) * k)] = grid.get(i, j, k);
+			const std::string what = std::string(narrow ? "sparse band " : "sparse full ") + g.name;
+			check_near(what + " vol", get_mc_vol_grid(grid), get_mc_vol_grid(dense.phi.data(), g.nx, g.ny, g.nz));
+			check_near(what + " area", get_mc_area_grid(grid), get_mc_area_grid(dense.phi.data(), g.nx, g.ny, g.nz));
+		}
+	}
+}
+
+//get_mc_grid_stream: a raw file with a header and padding between the slices gives the totals of
+//get_mc_vol_grid/get_mc_area_grid bitwise. a missing or truncated file returns false, and the walk
+//stops at the first slice that cannot be read
+void test_stream()
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "fraction_test_stream.raw").string();
+	for (const TestGrid& g : make_test_grids()) {
+		const std::uint64_t offset = 64, slice_bytes = std::uint64_t(g.nx) * g.ny * sizeof(fType), slice_stride = slice_bytes + 24;
+		std::string bytes(offset + slice_stride * g.nz, '\0');
+		for (iType k = 0; k < g.nz; ++k) std::memcpy(&bytes[offset + slice_stride * k], &g.phi[std::size_t(g.nx) * g.ny * k], slice_bytes);
+		std::ofstream(path, std::ios::binary).write(bytes.data(), std::streamsize(bytes.size()));
+
+		const MCRawFile file{ path, g.nx, g.ny, g.nz, offset, slice_stride };
+		fType vol = -1.0, area = -1.0;
+		MCStreamStats stats;
+		check("stream " + g.name, get_mc_grid_stream<fType>(file, vol, area, &stats));
+		check("stream vol bitwise " + g.name, vol == get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check("stream area bitwise " + g.name, area == get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check("stream bytes read " + g.name, stats.bytes_read == slice_bytes * g.nz);
+
+		//the file ends in the middle of slice 5
+		std::filesystem::resize_file(path, offset + slice_stride * 5 + slice_bytes / 2);
+		check("stream truncated " + g.name, !get_mc_grid_stream<fType>(file, vol, area, &stats) && vol == 0.0 && area == 0.0);
+		check("stream truncated bytes read " + g.name, stats.bytes_read == slice_bytes * 5);
+	}
+	std::filesystem::remove(path);
+	fType vol, area;
+	check("stream missing file", !get_mc_grid_stream<fType>(MCRawFile{ path, 4, 4, 4 }, vol, area));
+}
+
+//get_mc_grid_fields: each field matches get_mc_vol_grid/get_mc_area_grid of its own array bitwise,
+//with separate and with interleaved arrays, on the whole grid and on a box, and get_mc_grid_fields_parallel
+//matches get_mc_vol_grid_parallel/get_mc_area_grid_parallel bitwise
+void test_fields()
+{
+	constexpr iType num = 3;
+	for (const TestGrid& g : make_test_grids()) {
+		std::vector<std::vector<fType>> soa(num, g.phi);
+		std::vector<fType> interleaved(g.phi.size() * num);
+		for (std::size_t n = 0; n < g.phi.size(); ++n) {
+			for (iType f = 0; f < num; ++f) {
+				soa[f][n] = g.phi[n] + 0.37 * (f - 1) + 0.1 * f * std::sin(0.3 * double(n));
+				interleaved[num * n + f] = soa[f][n];
+			}
+		}
+		const MCFields<fType> separate{ { soa[0].data(), soa[1].data(), soa[2].data() }, 1 };
+		const MCBox box{ 3, 5, 2, g.nx - 4, g.ny - 2, g.nz - 7 };
+		for (const bool is_interleaved : { false, true }) {
+			const MCFields<fType> fields = is_interleaved ? get_mc_interleaved_fields(interleaved.data(), num) : separate;
+			const std::string what = std::string(is_interleaved ? "fields interleaved " : "fields separate ") + g.name;
+			std::array<fType, num> vol, area, box_vol, box_area, parallel_vol, parallel_area;
+			get_mc_grid_fields(fields, g.nx, g.ny, g.nz, vol.data(), area.data());
+			get_mc_grid_fields(fields, g.nx, g.ny, box, box_vol.data(), box_area.data());
+			get_mc_grid_fields_parallel(fields, g.nx, g.ny, g.nz, parallel_vol.data(), parallel_area.data(), ThreadExecutor{ 3 });
+			bool same = true;
+			for (iType f = 0; f < num; ++f) {
+				const fType* phi = soa[f].data();
+				same = same && vol[f] == get_mc_vol_grid(phi, g.nx, g.ny, g.nz) && area[f] == get_mc_area_grid(phi, g.nx, g.ny, g.nz);
+				same = same && box_vol[f] == get_mc_vol_grid(phi, g.nx, g.ny, box) && box_area[f] == get_mc_area_grid(phi, g.nx, g.ny, box);
+				same = same && parallel_vol[f] == get_mc_vol_grid_parallel(phi, g.nx, g.ny, g.nz) && parallel_area[f] == get_mc_area_grid_parallel(phi, g.nx, g.ny, g.nz);
+			}
+			check(what, same);
+		}
+	}
+}
+
+//get_mc_fraction_fields: every cell and every face is written once, the cells match get_mc_vol of their corner
+//values and the faces get_ms_area of their corner values bitwise, and the fields are the same for any number of threads
+void test_fraction_fields()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		const iType nx = g.nx, ny = g.ny, nz = g.nz, mx = nx - 1, my = ny - 1, mz = nz - 1;
+		const auto get_face = [](const S4& v) {
+			const iType table_index = get_ms_table_index(v);
+			return table_index == 0 ? 0.0 : table_index == 15 ? 1.0 : get_ms_area(v);
+		};
+		std::array<std::vector<fType>, 4> fields[2];
+		for (iType n = 0; n < 2; ++n) {
+			std::array<std::vector<fType>, 4>& f = fields[n];
+			f[0].assign(std::size_t(mx) * my * mz, NAN);
+			f[1].assign(std::size_t(nx) * my * mz, NAN);
+			f[2].assign(std::size_t(mx) * ny * mz, NAN);
+			f[3].assign(std::size_t(mx) * my * nz, NAN);
+			get_mc_fraction_fields(g.phi.data(), nx, ny, nz, f[0].data(), f[1].data(), f[2].data(), f[3].data(), ThreadExecutor{ n == 0 ? 1 : 3 });
+		}
+		const std::array<std::vector<fType>, 4>& f = fields[1];
+		bool same = fields[0] == fields[1];
+		for (iType k = 0; k < nz; ++k) {
+			for (iType j = 0; j < ny; ++j) {
+				for (iType i = 0; i < nx; ++i) {
+					if (i < mx && j < my && k < mz) {
+						const S8 v = g.get_cell(i, j, k);
+						const iType table_index = get_mc_table_index(v);
+						same = same && f[0][i + std::size_t(mx) * (j + std::size_t(my) * k)] == (table_index == 0 ? 0.0 : table_index == 255 ? 1.0 : get_mc_vol(v));
+					}
+					if (j < my && k < mz)
+						same = same && f[1][i + std::size_t(nx) * (j + std::size_t(my) * k)] == get_face({ g.at(i, j, k), g.at(i, j + 1, k), g.at(i, j + 1, k + 1), g.at(i, j, k + 1) });
+					if (i < mx && k < mz)
+						same = same && f[2][i + std::size_t(mx) * (j + std::size_t(ny) * k)] == get_face({ g.at(i, j, k), g.at(i + 1, j, k), g.at(i + 1, j, k + 1), g.at(i, j, k + 1) });
+					if (i < mx && j < my)
+						same = same && f[3][i + std::size_t(mx) * (j + std::size_t(my) * k)] == get_face({ g.at(i, j, k), g.at(i + 1, j, k), g.at(i + 1, j + 1, k), g.at(i, j + 1, k) });
+				}
+			}
+		}
+		check("fraction fields " + g.name, same);
+	}
+}
+
+//get_ms_image: on images of more than one band of rows with a row stride larger than the width, each quad
+//matches get_ms_area/get_ms_len of its corner values bitwise, and the totals are bitwise identical for any
+//number of threads and equal to the per-quad sums up to rounding
+void test_ms_image()
+{
+	const iType nx = 157, ny = 2 * ms_band_rows + 37, stride = nx + 5;
+	const auto length = [](fType x, fType y) { return std::sqrt(x * x + y * y); };
+	const std::pair<std::string, std::function<fType(fType, fType)>> images[] = {
+		{ "disk", [=](fType x, fType y) { return length(x - 71.3, y - 80.6) - 52.9; } },
+		{ "noise", [](fType x, fType y) { return std::sin(0.7 * x + 0.2 * y) * std::cos(0.5 * y - 0.3 * x) + 0.1; } },
+		{ "quantized", [=](fType x, fType y) { return std::round(2.0 * (length(x - 80.0, y - 60.0) - 40.0)) / 2.0; } },
+	};
+	for (const auto& image : images) {
+		std::vector<fType> phi(std::size_t(stride) * ny, NAN);
+		for (iType j = 0; j < ny; ++j)
+			for (iType i = 0; i < nx; ++i) phi[i + std::size_t(stride) * j] = image.second(fType(i), fType(j));
+		std::vector<fType> quad_area(std::size_t(nx - 1) * (ny - 1)), quad_len(quad_area.size());
+		fType area, len, area1, len1;
+		get_ms_image(phi.data(), nx, ny, stride, area, len, quad_area.data(), quad_len.data(), ThreadExecutor{ 3 });
+		get_ms_image(phi.data(), nx, ny, stride, area1, len1, static_cast<fType*>(nullptr), static_cast<fType*>(nullptr), ThreadExecutor{ 1 });
+		check("ms image threads bitwise " + image.first, area == area1 && len == len1);
+
+		bool same = true;
+		double sum_area = 0.0, sum_len = 0.0;
+		for (iType j = 0; j + 1 < ny; ++j) {
+			for (iType i = 0; i + 1 < nx; ++i) {
+				const fType* r0 = phi.data() + std::size_t(stride) * j;
+				const fType* r1 = r0 + stride;
+				const S4 v{ r0[i], r0[i + 1], r1[i + 1], r1[i] };
+				const std::size_t q = i + std::size_t(nx - 1) * j;
+				same = same && quad_area[q] == get_ms_area(v) && quad_len[q] == get_ms_len(v);
+				sum_area += get_ms_area(v);
+				sum_len += get_ms_len(v);
+			}
+		}
+		check("ms image quads bitwise " + image.first, same);
+		check_near("ms image area " + image.first, area, sum_area);
+		check_near("ms image len " + image.first, len, sum_len);
+	}
+}
+
+//get_mc_grid_iso: for sorted iso values, including repeated ones, ones below and above all node values,
+//and ones equal to node values, the totals match get_mc_vol_grid/get_mc_area_grid of the shifted grid up to
+//rounding, and get_mc_grid_iso_parallel is bitwise identical for any number of threads
+void test_iso()
+{
+	const std::vector<fType> iso{ -100.0, -0.6, -0.25, 0.0, 0.0, 0.25, 0.3, 100.0 };
+	const iType num = iType(iso.size());
+	for (const TestGrid& g : make_test_grids()) {
+		std::vector<fType> vol(num), area(num), vol1(num), area1(num), vol3(num), area3(num);
+		get_mc_grid_iso(g.phi.data(), g.nx, g.ny, g.nz, iso.data(), num, vol.data(), area.data());
+		get_mc_grid_iso_parallel(g.phi.data(), g.nx, g.ny, g.nz, iso.data(), num, vol1.data(), area1.data(), ThreadExecutor{ 1 });
+		get_mc_grid_iso_parallel(g.phi.data(), g.nx, g.ny, g.nz, iso.data(), num, vol3.data(), area3.data(), ThreadExecutor{ 3 });
+		check("iso parallel bitwise " + g.name, vol1 == vol3 && area1 == area3);
+		for (iType n = 0; n < num; ++n) {
+			std::vector<fType> shifted(g.phi);
+			for (fType& v : shifted) v -= iso[n];
+			const std::string what = "iso " + std::to_string(iso[n]) + " " + g.name;
+			const fType shifted_vol = get_mc_vol_grid(shifted.data(), g.nx, g.ny, g.nz), shifted_area = get_mc_area_grid(shifted.data(), g.nx, g.ny, g.nz);
+			check_near(what + " vol", vol[n], shifted_vol);
+			check_near(what + " area", area[n], shifted_area);
+			check_near(what + " parallel vol", vol3[n], shifted_vol);
+			check_near(what + " parallel area", area3[n], shifted_area);
+		}
+	}
+}
+
+//get_mc_vol_grad_grid/get_mc_area_grad_grid: the gradient field is the sum of the per-cell gradients of
+//get_mc_vol_grad/get_mc_area_grad and the total matches get_mc_vol_grid/get_mc_area_grid; the brick-parallel
+//versions give the same field up to rounding, bitwise the same for any number of threads; the volume gradient
+//of the sphere matches central differences of get_mc_vol_grid at nodes away from the iso value
+void test_grad()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		for (const bool vol : { true, false }) {
+			const std::string what = std::string(vol ? "grad vol " : "grad area ") + g.name;
+			const std::size_t size = g.phi.size();
+			std::vector<fType> grad(size), grad1(size), grad3(size), expected(size);
+			fType total, total1, total3;
+			if (vol) {
+				total = get_mc_vol_grad_grid(g.phi.data(), g.nx, g.ny, g.nz, grad.data());
+				total1 = get_mc_vol_grad_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, grad1.data(), ThreadExecutor{ 1 });
+				total3 = get_mc_vol_grad_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, grad3.data(), ThreadExecutor{ 3 });
+			}
+			else {
+				total = get_mc_area_grad_grid(g.phi.data(), g.nx, g.ny, g.nz, grad.data());
+				total1 = get_mc_area_grad_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, grad1.data(), ThreadExecutor{ 1 });
+				total3 = get_mc_area_grad_grid_parallel(g.phi.data(), g.nx, g.ny, g.nz, grad3.data(), ThreadExecutor{ 3 });
+			}
+			for (iType k = 0; k + 1 < g.nz; ++k) {
+				for (iType j = 0; j + 1 < g.ny; ++j) {
+					for (iType i = 0; i + 1 < g.nx; ++i) {
+						const S8 v = g.get_cell(i, j, k);
+						const iType table_index = get_mc_table_index(v);
+						if (table_index == 0 || table_index == 255) continue;
+						const MCDual<fType, 8> d = vol ? get_mc_vol_grad(v) : get_mc_area_grad(v);
+						for (iType c = 0; c < 8; ++c) {
+							const std::size_t n = i + mc_corners[c][0] + std::size_t(g.nx) * (j + mc_corners[c][1] + std::size_t(g.ny) * (k + mc_corners[c][2]));
+							expected[n] += d.grad[c];
+						}
+					}
+				}
+			}
+			const fType grid_total = vol ? get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz) : get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz);
+			check_near(what + " total", total, grid_total);
+			check_near(what + " parallel total", total3, grid_total);
+			check(what + " parallel bitwise", total1 == total3 && grad1 == grad3);
+			bool near = true;
+			for (std::size_t n = 0; n < size; ++n) {
+				near = near && std::abs(grad[n] - expected[n]) <= 1e-12 * std::max(1.0, std::abs(expected[n]));
+				near = near && std::abs(grad3[n] - expected[n]) <= 1e-12 * std::max(1.0, std::abs(expected[n]));
+			}
+			check(what + " field", near);
+		}
+	}
+	const TestGrid g = make_test_grids()[0];
+	std::vector<fType> grad(g.phi.size());
+	get_mc_vol_grad_grid(g.phi.data(), g.nx, g.ny, g.nz, grad.data());
+	std::vector<fType> phi(g.phi);
+	const fType h = 1e-6;
+	iType num_checked = 0;
+	for (std::size_t n = 0; n < phi.size(); n += 7) {
+		if (grad[n] == 0.0 || std::abs(phi[n]) < 1e-3) continue;
+		phi[n] = g.phi[n] + h;
+		const fType up = get_mc_vol_grid(phi.data(), g.nx, g.ny, g.nz);
+		phi[n] = g.phi[n] - h;
+		const fType down = get_mc_vol_grid(phi.data(), g.nx, g.ny, g.nz);
+		phi[n] = g.phi[n];
+		check_near("grad vol finite difference " + std::to_string(n), grad[n], (up - down) / (2.0 * h), 1e-5);
+		++num_checked;
+	}
+	check("grad vol finite difference nodes", num_checked > 0);
+}
+
+//get_mc_vol_approx: within mc_vol_approx_error of get_mc_vol on random cells of every table index, and equal up to
+//rounding for the table indices without a fit; get_mc_vol_grid_approx matches the per-cell sum and is within
+//mc_vol_approx_error per mixed cell of get_mc_vol_grid
+void test_approx()
+{
+	for (const S8& v : make_table_index_cells()) {
+		const iType table_index = get_mc_table_index(v);
+		const fType exact = get_mc_vol(v), approx = get_mc_vol_approx(v);
+		const std::string what = "approx table index " + std::to_string(table_index);
+		if (mc_vol_fits[mc_case_table[table_index].C].num == 0) check_near(what, approx, exact);
+		else check(what, std::abs(approx - exact) <= mc_vol_approx_error);
+	}
+	for (const TestGrid& g : make_test_grids()) {
+		iType num_mixed = 0;
+		const double sum = sum_test_cells(g, [&num_mixed](const S8& v) {
+			const iType table_index = get_mc_table_index(v);
+			num_mixed += table_index != 0 && table_index != 255;
+			return table_index == 0 ? 0.0 : table_index == 255 ? 1.0 : get_mc_vol_approx(v);
+		});
+		const fType approx = get_mc_vol_grid_approx(g.phi.data(), g.nx, g.ny, g.nz);
+		check_near("approx grid " + g.name, approx, sum);
+		check("approx grid bound " + g.name, std::abs(approx - get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz)) <= mc_vol_approx_error * num_mixed);
+	}
+}
+
+//get_mc_shard_result: the shards of a partition count every cell once and their merged result matches
+//get_mc_vol_grid/get_mc_area_grid, also with more shards than nodes along an axis; get_mc_shards_local
+//gives the merged result of the shards bitwise and returns false if a rank fails
+void test_shards()
+{
+	const iType partitions[][3] = { { 1, 1, 1 }, { 2, 3, 2 }, { 3, 1, 4 }, { 1, 50, 1 } };
+	for (const TestGrid& g : make_test_grids()) {
+		const std::uint64_t num_cells = std::uint64_t(g.nx - 1) * (g.ny - 1) * (g.nz - 1);
+		const fType vol = get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz), area = get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz);
+		const MCBox grid{ 0, 0, 0, g.nx, g.ny, g.nz };
+		const auto fill = [&g, &grid](const MCShard& s, fType* owned) { copy_mc_box_nodes(grid, g.phi.data(), s.nodes, owned); };
+		for (const auto& p : partitions) {
+			const std::string what = "shards " + std::to_string(p[0]) + "x" + std::to_string(p[1]) + "x" + std::to_string(p[2]) + " " + g.name;
+			const iType num = p[0] * p[1] * p[2];
+			std::vector<MCShardResult> partial(num);
+			for (iType r = 0; r < num; ++r) {
+				const MCShard s = get_mc_shard(g.nx, g.ny, g.nz, p[0], p[1], p[2], r);
+				const MCBox b = get_mc_shard_block(s);
+				std::vector<fType> block(get_mc_box_size(b));
+				copy_mc_box_nodes(grid, g.phi.data(), b, block.data());
+				partial[r] = get_mc_shard_result(block.data(), s);
+			}
+			const MCShardResult sum = get_mc_shard_sum(partial.data(), partial.size());
+			check(what + " cells", sum.num_cells == num_cells);
+			check_near(what + " vol", sum.vol.get(), vol);
+			check_near(what + " area", sum.area.get(), area);
+			MCShardResult local;
+			const bool good = get_mc_shards_local<fType>(g.nx, g.ny, g.nz, p[0], p[1], p[2], fill, local);
+			check(what + " local", good && local.num_cells == sum.num_cells && local.vol.get() == sum.vol.get() && local.area.get() == sum.area.get());
+		}
+		MCShardResult failed;
+		const bool good = get_mc_shards_local<fType>(g.nx, g.ny, g.nz, 2, 2, 1, [&fill](const MCShard& s, fType* owned) {
+			if (s.nodes.i0 > 0 && s.nodes.j0 > 0) throw 1;
+			fill(s, owned);
+		}, failed);
+		check("shards failed rank " + g.name, !good);
+	}
+}
+
+//get_mc_octree: a uniformly refined tree matches get_mc_vol_grid/get_mc_area_grid on its nodes scaled by h^3 and h^2,
+//and the result is bitwise the same for any number of threads. on an adaptive tree, all leaves around a node see
+//the same value after constrain, and a plane, which the constrained values reproduce exactly, has the volume
+//and area of the uniform tree
+void test_octree()
+{
+	constexpr iType max_level = 5, n = (1 << max_level) + 1;
+	const fType h = 1.0 / fType(1 << max_level);
+	const auto sphere = [](fType x, fType y, fType z) { return std::sqrt((x - 0.47) * (x - 0.47) + (y - 0.52) * (y - 0.52) + (z - 0.45) * (z - 0.45)) - 0.31; };
+	const auto plane = [](fType x, fType y, fType z) { return x + 0.3 * y + 0.2 * z - 0.71; };
+	const auto uniform = [](iType, const std::array<fType, 3>&, fType) { return true; };
+	const auto adaptive = [&sphere](const iType level, const std::array<fType, 3>& p, const fType s) {
+		return level < 2 || std::abs(sphere(p[0] + 0.5 * s, p[1] + 0.5 * s, p[2] + 0.5 * s)) < s;
+	};
+	for (const bool is_sphere : { true, false }) {
+		const std::function<fType(fType, fType, fType)> f = is_sphere ? std::function<fType(fType, fType, fType)>(sphere) : plane;
+		const std::string what = is_sphere ? "octree sphere" : "octree plane";
+		std::vector<fType> phi(std::size_t(n) * n * n);
+		for (iType k = 0; k < n; ++k)
+			for (iType j = 0; j < n; ++j)
+				for (iType i = 0; i < n; ++i) phi[i + std::size_t(n) * (j + std::size_t(n) * k)] = f(h * i, h * j, h * k);
+		MCOctree<fType> tree({ 0.0, 0.0, 0.0 }, 1.0, max_level);
+		tree.build(f, uniform);
+		fType vol1, area1, vol3, area3;
+		get_mc_octree(tree, vol1, area1, ThreadExecutor{ 1 });
+		get_mc_octree(tree, vol3, area3, ThreadExecutor{ 3 });
+		check_near(what + " uniform vol", vol1, h * h * h * get_mc_vol_grid(phi.data(), n, n, n));
+		check_near(what + " uniform area", area1, h * h * get_mc_area_grid(phi.data(), n, n, n));
+		check(what + " parallel bitwise", vol1 == vol3 && area1 == area3);
+
+		MCOctree<fType> adaptive_tree({ 0.0, 0.0, 0.0 }, 1.0, max_level);
+		adaptive_tree.build(f, adaptive);
+		check(what + " adaptive refined", adaptive_tree.child.size() > 1 && adaptive_tree.child.size() < tree.child.size());
+		std::map<std::array<iType, 3>, fType> nodes;
+		bool same = true;
+		const auto visit = [&](const auto& self, const std::int32_t cell, const iType level, const std::array<iType, 3>& c) -> void {
+			if (adaptive_tree.child[cell] != MCOctree<fType>::leaf) {
+				for (iType d = 0; d < 8; ++d)
+					self(self, adaptive_tree.child[cell] + d, level + 1, std::array<iType, 3>{ 2 * c[0] + (d & 1), 2 * c[1] + ((d >> 1) & 1), 2 * c[2] + ((d >> 2) & 1) });
+				return;
+			}
+			const iType s = max_level - level;
+			for (iType m = 0; m < 8; ++m) {
+				const std::array<iType, 3> node{ (c[0] + mc_corners[m][0]) << s, (c[1] + mc_corners[m][1]) << s, (c[2] + mc_corners[m][2]) << s };
+				const auto [it, inserted] = nodes.insert({ node, adaptive_tree.corners[cell][m] });
+				same = same && (inserted || it->second == adaptive_tree.corners[cell][m]);
+			}
+		};
+		visit(visit, 0, 0, std::array<iType, 3>{ 0, 0, 0 });
+		check(what + " adaptive nodes", same);
+		if (is_sphere) continue;
+		fType vol, area;
+		get_mc_octree(adaptive_tree, vol, area);
+		check_near(what + " adaptive vol", vol, vol1);
+		check_near(what + " adaptive area", area, area1);
+	}
+}
+
+//cell spacing: MCIsoSpacing scales the unit-cube volume by h^3 and the area by h^2, and MCSpacing with equal sides
+//matches it; the anisotropic area of a grid equals the area of its mesh with the vertices scaled by (dx, dy, dz),
+//and the anisotropic volume is the unit volume times dx dy dz
+void test_spacing()
+{
+	const fType h = 0.37;
+	const MCSpacing<fType> aniso{ 0.7, 1.9, 0.45 };
+	for (const S8& v : make_table_index_cells(4)) {
+		const iType table_index = get_mc_table_index(v);
+		if (table_index == 0 || table_index == 255) continue;
+		const std::string what = "spacing table index " + std::to_string(table_index);
+		const fType vol = get_mc_vol(v), area = get_mc_area(v);
+		check_near(what + " iso vol", get_mc_vol(v, MCIsoSpacing<fType>{ h }), h * h * h * vol);
+		check_near(what + " iso area", get_mc_area(v, MCIsoSpacing<fType>{ h }), h * h * area);
+		check_near(what + " equal sides area", get_mc_area(v, MCSpacing<fType>{ h, h, h }), h * h * area);
+		check_near(what + " unit sides area", get_mc_area(v, MCSpacing<fType>{}), area);
+		check_near(what + " aniso vol", get_mc_vol(v, aniso), aniso.dx * aniso.dy * aniso.dz * vol);
+	}
+	for (const TestGrid& g : make_test_grids()) {
+		const fType vol = get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz), area = get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz);
+		check_near("spacing iso vol " + g.name, get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz, MCIsoSpacing<fType>{ h }), h * h * h * vol);
+		check_near("spacing iso area " + g.name, get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz, MCIsoSpacing<fType>{ h }), h * h * area);
+		check_near("spacing aniso vol " + g.name, get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz, aniso), aniso.dx * aniso.dy * aniso.dz * vol);
+		check_near("spacing aniso area " + g.name, get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz, aniso),
+			get_test_mesh_area(make_test_mesh(g), { aniso.dx, aniso.dy, aniso.dz }), 1e-9);
+	}
+}
+
+//get_mc_components: the labels are the classes of the inside nodes connected by grid edges, each region starts at its
+//smallest node, the region sums add up to get_mc_vol_grid/get_mc_area_grid, and the regions and labels are bitwise
+//the same for any number of threads; two separate spheres give two regions with the volume and area of each sphere
+void test_components()
+{
+	const auto length = [](fType x, fType y, fType z) { return std::sqrt(x * x + y * y + z * z); };
+	const auto first = [=](fType x, fType y, fType z) { return length(x - 10.2, y - 11.7, z - 9.4) - 6.3; };
+	const auto second = [=](fType x, fType y, fType z) { return length(x - 27.5, y - 24.1, z - 21.6) - 7.9; };
+	std::vector<TestGrid> grids = make_test_grids();
+	grids.push_back(make_test_grid("two spheres", 39, 35, 33, [=](fType x, fType y, fType z) { return std::min(first(x, y, z), second(x, y, z)); }));
+	for (const TestGrid& g : grids) {
+		const std::size_t nxy = std::size_t(g.nx) * g.ny;
+		std::vector<iType> labels1(g.phi.size()), labels3(g.phi.size());
+		const std::vector<MCComponent<fType>> c1 = get_mc_components(g.phi.data(), g.nx, g.ny, g.nz, labels1.data(), ThreadExecutor{ 1 });
+		const std::vector<MCComponent<fType>> c3 = get_mc_components(g.phi.data(), g.nx, g.ny, g.nz, labels3.data(), ThreadExecutor{ 3 });
+		bool same = c1.size() == c3.size() && labels1 == labels3;
+		for (std::size_t n = 0; same && n < c1.size(); ++n) same = c1[n].vol == c3[n].vol && c1[n].area == c3[n].area && c1[n].node == c3[n].node;
+		check("components parallel bitwise " + g.name, same);
+
+		bool connected = true;
+		std::vector<std::int64_t> smallest(c1.size(), -1);
+		for (iType k = 0; k < g.nz; ++k) {
+			for (iType j = 0; j < g.ny; ++j) {
+				for (iType i = 0; i < g.nx; ++i) {
+					const std::size_t m = i + std::size_t(g.nx) * j + nxy * k;
+					const iType label = labels1[m];
+					if (!(g.phi[m] < iso_value)) {
+						connected = connected && label == -1;
+						continue;
+					}
+					if (label < 0 || label >= iType(c1.size())) {
+						connected = false;
+						continue;
+					}
+					if (smallest[label] < 0) smallest[label] = std::int64_t(m);
+					if (i + 1 < g.nx && g.phi[m + 1] < iso_value) connected = connected && labels1[m + 1] == label;
+					if (j + 1 < g.ny && g.phi[m + g.nx] < iso_value) connected = connected && labels1[m + g.nx] == label;
+					if (k + 1 < g.nz && g.phi[m + nxy] < iso_value) connected = connected && labels1[m + nxy] == label;
+				}
+			}
+		}
+		bool ordered = true;
+		for (std::size_t n = 0; n < c1.size(); ++n) ordered = ordered && c1[n].node == smallest[n] && (n == 0 || c1[n - 1].node < c1[n].node);
+		check("components labels " + g.name, connected);
+		check("components smallest nodes " + g.name, ordered);
+
+		double vol = 0.0, area = 0.0;
+		for (const MCComponent<fType>& c : c1) {
+			vol += c.vol;
+			area += c.area;
+		}
+		check_near("components vol " + g.name, vol, get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("components area " + g.name, area, get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		if (g.name != "two spheres") continue;
+		check("components two spheres", c1.size() == 2);
+		if (c1.size() != 2) continue;
+		for (iType n = 0; n < 2; ++n) {
+			const TestGrid sphere = make_test_grid("sphere", g.nx, g.ny, g.nz, n == 0 ? std::function<fType(fType, fType, fType)>(first) : second);
+			check_near("components sphere " + std::to_string(n) + " vol", c1[n].vol, get_mc_vol_grid(sphere.phi.data(), g.nx, g.ny, g.nz));
+			check_near("components sphere " + std::to_string(n) + " area", c1[n].area, get_mc_area_grid(sphere.phi.data(), g.nx, g.ny, g.nz));
+		}
+	}
+}
+
+//get_mc_vol_area_grid: the volume and area equal get_mc_vol_grid/get_mc_area_grid bitwise, the triangle areas add up
+//to the area, and the meshes of surfaces inside the grid are closed and oriented to the outside, so their divergence
+//volume is the volume; 64-bit indices give the same mesh, and indices too small for the vertices leave it incomplete
+void test_mesh()
+{
+	for (const TestGrid& g : make_test_grids()) {
+		const TestMesh m = make_test_mesh(g);
+		const std::size_t num_vertices = m.vertices.size() / 3;
+		check("mesh vol area bitwise " + g.name, m.vol == get_mc_vol_grid(g.phi.data(), g.nx, g.ny, g.nz) && m.area == get_mc_area_grid(g.phi.data(), g.nx, g.ny, g.nz));
+		check_near("mesh area " + g.name, get_test_mesh_area(m), m.area, 1e-9);
+		bool valid = !m.triangles.empty();
+		for (const std::uint32_t v : m.triangles) valid = valid && v < num_vertices;
+		check("mesh indices " + g.name, valid);
+
+		std::vector<fType> vertices(m.vertices.size());
+		std::vector<std::uint64_t> triangles(m.triangles.size());
+		MCMesh<fType, std::uint64_t> wide{ vertices.data(), triangles.data(), num_vertices, m.triangles.size() / 3 };
+		fType vol, area;
+		get_mc_vol_area_grid(g.phi.data(), g.nx, g.ny, g.nz, vol, area, &wide);
+		check("mesh 64-bit " + g.name, wide.complete() && vertices == m.vertices && std::equal(triangles.begin(), triangles.end(), m.triangles.begin()));
+		MCMesh<fType, std::uint8_t> narrow;
+		get_mc_vol_area_grid(g.phi.data(), g.nx, g.ny, g.nz, vol, area, &narrow);
+		check("mesh 8-bit incomplete " + g.name, !narrow.complete() && narrow.num_vertices > narrow.max_index && vol == m.vol && area == m.area);
+		if (g.name == "noise") continue;
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> edges, reversed;
+		double divergence = 0.0;
+		for (std::size_t t = 0; t < m.triangles.size(); t += 3) {
+			for (iType l = 0; l < 3; ++l) {
+				edges.push_back({ m.triangles[t + l], m.triangles[t + (l + 1) % 3] });
+				reversed.push_back({ m.triangles[t + (l + 1) % 3], m.triangles[t + l] });
+			}
+			const fType* a = &m.vertices[3 * std::size_t(m.triangles[t])];
+			const fType* b = &m.vertices[3 * std::size_t(m.triangles[t + 1])];
+			const fType* c = &m.vertices[3 * std::size_t(m.triangles[t + 2])];
+			divergence += (a[0] * (b[1] * c[2] - b[2] * c[1]) + a[1] * (b[2] * c[0] - b[0] * c[2]) + a[2] * (b[0] * c[1] - b[1] * c[0])) / 6.0;
+		}
+		std::sort(edges.begin(), edges.end());
+		std::sort(reversed.begin(), reversed.end());
+		check("mesh closed " + g.name, std::adjacent_find(edges.begin(), edges.end()) == edges.end() && edges == reversed);
+		check_near("mesh divergence vol " + g.name, divergence, m.vol, 1e-9);
+	}
+}
+
+//=================================================================================================
+//
+//=================================================================================================
+
+struct Test
+{
+	const char* name;
+	void (*run)();
+};
+
+int main(int argc, char** argv)
+{
+	const Test tests[] = {
+		{ "grid", test_grid },
+		{ "parallel", test_parallel },
+		{ "simd", test_simd },
+		{ "binned", test_binned },
+		{ "pyramid", test_pyramid },
+		{ "float", test_float },
+		{ "backend", test_backend },
+		{ "stats", test_stats },
+		{ "dispatch", test_dispatch },
+		{ "measures", test_measures },
+		{ "tracker", test_tracker },
+		{ "sparse", test_sparse },
+		{ "stream", test_stream },
+		{ "fields", test_fields },
+		{ "fraction_fields", test_fraction_fields },
+		{ "ms_image", test_ms_image },
+		{ "iso", test_iso },
+		{ "grad", test_grad },
+		{ "approx", test_approx },
+		{ "shards", test_shards },
+		{ "octree", test_octree },
+		{ "spacing", test_spacing },
+		{ "components", test_components },
+		{ "mesh", test_mesh },
+	};
+	bool found = false;
+	for (const Test& t : tests) {
+		if (argc > 1 && std::strcmp(argv[1], t.name)) continue;
+		found = true;
+		const int failed = num_failed;
+		t.run();
+		std::printf("%-12s %s\n", t.name, num_failed == failed ? "ok" : "FAILED");
+	}
+	if (!found) {
+		std::printf("no test named %s\n", argv[1]);
+		return 1;
+	}
+	return num_failed > 0 ? 1 : 0;
+}
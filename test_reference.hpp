@@ -0,0 +1,267 @@
+#ifndef TEST_REFERENCE_HPP
+#define TEST_REFERENCE_HPP
+
+//get_mc_vol and get_mc_area of the cells of make_table_index_cells(2), { vol, area } per cell and table index,
+//computed with the kernels and the hand-written case table of fraction.hpp before the table was generated
+//(0 and 1 for the table indices 0 and 255, which are not evaluated). the table pins the triangulation of the
+//ambiguous table indices, which the rotation of mc_case_rotations selects
+constexpr double mc_reference_results[256][2][2] = {
+	{ { 0, 0 }, { 0, 0 } },
+	{ { 0.015794649787363769, 0.19500879321409992 }, { 0.013769765270990679, 0.19686842571013988 } },
+	{ { 0.039615249792157865, 0.34121945418553468 }, { 0.033334406779965658, 0.32287395537360752 } },
+	{ { 0.047607170833980535, 0.5528869766321024 }, { 0.17883960480643316, 0.90527230266931324 } },
+	{ { 0.051728838796702342, 0.41510291286848588 }, { 0.01877816449689124, 0.20425296784617525 } },
+	{ { 0.13829090359684465, 1.0047496479381144 }, { 0.044412927890844264, 0.43089480139050135 } },
+	{ { 0.22732730309655103, 0.94161173490576733 }, { 0.21751900232598956, 0.95491494236768482 } },
+	{ { 0.33752165811929219, 1.1373187538308027 }, { 0.38358794955311937, 1.3257463325703729 } },
+	{ { 0.021743704665930622, 0.2413028906798976 }, { 0.03174348246022364, 0.33146041518893271 } },
+	{ { 0.09831776237380771, 0.63363919232597898 }, { 0.097413070127591331, 0.65260168055063983 } },
+	{ { 0.024184415542335608, 0.27908198290188058 }, { 0.13823258284083545, 0.97127883775946389 } },
+	{ { 0.44924588651595199, 1.300564140827559 }, { 0.46204584622489586, 1.1701828308010132 } },
+	{ { 0.11571163087811832, 0.6673109998038711 }, { 0.13862845992120423, 0.77220445342383504 } },
+	{ { 0.22915135720738128, 0.97438283715651286 }, { 0.23061188901918572, 1.1387073318831664 } },
+	{ { 0.40352632431226371, 1.279289773951457 }, { 0.41475803444140769, 1.4297948792725841 } },
+	{ { 0.65067729125850526, 1.079559415508788 }, { 0.73989274293809371, 1.1044187019395948 } },
+	{ { 0.07432238298538954, 0.50977088856809694 }, { 0.0082602875026488425, 0.14633840547622748 } },
+	{ { 0.042042685785442298, 0.42806661008089536 }, { 0.1943387268397703, 0.97048626499069068 } },
+	{ { 0.079813201577228682, 0.58254002541551675 }, { 0.031511248633884451, 0.33346140212421971 } },
+	{ { 0.34701264507060076, 1.2941575584006744 }, { 0.31869049930105808, 1.2888372325118098 } },
+	{ { 0.044001441817070025, 0.44880833570273809 }, { 0.045029506662566929, 0.40576897503221282 } },
+	{ { 0.10633435495429924, 0.75566956536471097 }, { 0.18191810194726998, 1.238306906795426 } },
+	{ { 0.19752978501399965, 1.0269876150861821 }, { 0.032708990146013472, 0.56668830490508471 } },
+	{ { 0.59998575058072912, 1.6013633077094305 }, { 0.43670571484810683, 2.0171864921847864 } },
+	{ { 0.03314882033737282, 0.30987236198723001 }, { 0.10452845884619966, 0.78150790527551006 } },
+	{ { 0.53215630132607994, 1.4419904445637335 }, { 0.25111285161187669, 1.0184105691719176 } },
+	{ { 0.035662254063397555, 0.31182183358811744 }, { 0.03912146626096534, 0.38000969612041813 } },
+	{ { 0.59493026703138452, 1.2627712995930547 }, { 0.54063130935685377, 1.3293971172562817 } },
+	{ { 0.14756878973285181, 0.78547901119674945 }, { 0.1278729542010614, 0.85409176384117569 } },
+	{ { 0.57322059393880154, 1.4923738695493804 }, { 0.50246473154777804, 1.5110163006348889 } },
+	{ { 0.40061687938731572, 1.6235939866928732 }, { 0.42437123847268493, 1.5448470016872058 } },
+	{ { 0.58607509722743112, 1.1853667661389324 }, { 0.54473679643060458, 1.1779747001092373 } },
+	{ { 0.044560897256853416, 0.38015747907043196 }, { 0.018065977176045564, 0.21154941499577837 } },
+	{ { 0.050848456966526109, 0.52873542371437132 }, { 0.19357217653569425, 1.2397544001934455 } },
+	{ { 0.06266600445584708, 0.500845516127708 }, { 0.098515228903705898, 0.62854533625873565 } },
+	{ { 0.61474629220675814, 1.3826858779893119 }, { 0.36866752223929722, 1.135051692578271 } },
+	{ { 0.18833977952958203, 1.226233899196552 }, { 0.023663849707266635, 0.30245031855335525 } },
+	{ { 0.078280845991950898, 0.76345660805884874 }, { 0.045880284480138131, 0.4972872862588647 } },
+	{ { 0.3042833943896362, 1.096296305360549 }, { 0.36410910309425198, 1.4752749939593579 } },
+	{ { 0.73200476913856272, 1.1229399986556226 }, { 0.48453463962691445, 1.2977081985973087 } },
+	{ { 0.15231177371762497, 1.082126879138984 }, { 0.074089522712706746, 0.65090192460556917 } },
+	{ { 0.25707148018537751, 1.3772380672639097 }, { 0.17003089265259336, 0.94466569564127822 } },
+	{ { 0.15095854747049609, 0.99755988858310285 }, { 0.15553593988600878, 0.96533469064059729 } },
+	{ { 0.41856684223320162, 1.8551599537171286 }, { 0.58852309511909318, 1.582416594352799 } },
+	{ { 0.08724029500158878, 0.76223675492644161 }, { 0.13186280230913311, 0.84806274968501238 } },
+	{ { 0.41850488685358889, 1.548199842205547 }, { 0.7557488479733433, 2.0496334916926231 } },
+	{ { 0.47987348304505084, 1.7800032750263279 }, { 0.34768493062739914, 1.4225413059811194 } },
+	{ { 0.51804553803540454, 1.2552426290110401 }, { 0.50419953972099185, 1.3103562348320055 } },
+	{ { 0.11545108660017442, 0.7406131563440197 }, { 0.076668871350975693, 0.54466710630135695 } },
+	{ { 0.41340803824827216, 1.3570853935277565 }, { 0.27401974501791904, 1.092864244738827 } },
+	{ { 0.27720430473639002, 1.0548551731184364 }, { 0.50693315205690981, 1.3471885049423666 } },
+	{ { 0.49277626211334891, 1.1181657939779166 }, { 0.87437837930627549, 1.0200554472393777 } },
+	{ { 0.042397483993575888, 0.48230678783718856 }, { 0.11729076663538615, 0.86585192967029712 } },
+	{ { 0.25831828811909174, 1.094165266109711 }, { 0.24042638271301575, 1.0200199538774768 } },
+	{ { 0.5407845556218257, 1.5900061288159937 }, { 0.62125492125452464, 2.0874232863392841 } },
+	{ { 0.64415938293982433, 1.1454404116795558 }, { 0.65419622876381833, 1.175374645976369 } },
+	{ { 0.011338606176926478, 0.22021640476375945 }, { 0.2911529677801446, 1.3555200508033578 } },
+	{ { 0.47642412247356936, 1.5250987997886811 }, { 0.38773832482999776, 1.5795489779184346 } },
+	{ { 0.31843635200465026, 1.3431781575384105 }, { 0.45548740175992947, 1.7272503875103857 } },
+	{ { 0.65701561424513455, 1.1516532215249846 }, { 0.50925304024046436, 1.3683691362554815 } },
+	{ { 0.16487310361163215, 1.114617723648534 }, { 0.34420202093055208, 1.6673333010092164 } },
+	{ { 0.37879867785665222, 1.7264822829067852 }, { 0.42191888715782072, 1.8923413404708809 } },
+	{ { 0.39482950685953661, 1.993932100576203 }, { 0.65624691670474333, 2.1969383123088688 } },
+	{ { 0.86565545056803239, 0.82353716650893927 }, { 0.92942052345898329, 0.51519417260818667 } },
+	{ { 0.0005714778749169035, 0.019989419115052812 }, { 0.029848970650955299, 0.27749299893861812 } },
+	{ { 0.024766645401389023, 0.31078256178843577 }, { 0.034815799264068498, 0.39123818339792815 } },
+	{ { 0.091086724061292201, 0.78550591924950997 }, { 0.077210808729279712, 0.65807256622242383 } },
+	{ { 0.14805430709416639, 0.8342827419040808 }, { 0.21162613227656502, 1.2507029558708134 } },
+	{ { 0.23879643070949258, 0.9876314904946597 }, { 0.042196774170729236, 0.44012658047119607 } },
+	{ { 0.12865581779595714, 0.82657593975776145 }, { 0.10814009653972581, 0.97658905157155462 } },
+	{ { 0.41336434337321987, 1.1884868143884808 }, { 0.33717502889074247, 1.4798831192130864 } },
+	{ { 0.52172067688514345, 1.6747853602407663 }, { 0.49099167598195526, 1.3843051043300465 } },
+	{ { 0.033806268917582941, 0.34185081676525381 }, { 0.12214443591468079, 0.9467263023953405 } },
+	{ { 0.42904399509327634, 1.6277762335173867 }, { 0.12835163422380846, 1.0806317457530668 } },
+	{ { 0.056949923186042084, 0.56117181760329748 }, { 0.16024545835439399, 1.2407743716760584 } },
+	{ { 0.37468210877326003, 1.4413610141062727 }, { 0.24515859356358996, 1.3252409649627865 } },
+	{ { 0.3597677790348815, 1.2614972150838906 }, { 0.38655476232336899, 1.1496901230686951 } },
+	{ { 0.53386345963298887, 1.6500492115517187 }, { 0.42514346012297349, 1.3483101505356043 } },
+	{ { 0.33345150369063098, 1.2109238462800986 }, { 0.43026370176617434, 1.4214074256816427 } },
+	{ { 0.51084448771738933, 1.2845662839759764 }, { 0.70581672350453273, 1.089162322608785 } },
+	{ { 0.13261414714132819, 0.95086901712332805 }, { 0.057408357999197725, 0.54415213334719659 } },
+	{ { 0.13649450545137634, 0.84449989719178487 }, { 0.17686097589589322, 1.0544602562273169 } },
+	{ { 0.11765407070629733, 1.1174814943073814 }, { 0.13797777457982568, 1.1314239499847161 } },
+	{ { 0.36929140813061678, 1.4795966581560136 }, { 0.37245454490052887, 1.4577441926005414 } },
+	{ { 0.079348914936913567, 0.89436524525869887 }, { 0.16255495525483862, 1.0970426195924112 } },
+	{ { 0.20269015802999724, 1.2752574927106939 }, { 0.55548183905145865, 2.1526588832145528 } },
+	{ { 0.28239619959667273, 1.0845630353377016 }, { 0.51053646810600828, 1.5469541903049426 } },
+	{ { 0.65844412074622571, 1.5189108787297796 }, { 0.47603154662234781, 1.7501506617041862 } },
+	{ { 0.13720769813908584, 1.131353701575649 }, { 0.063153068441997404, 0.64404894248357247 } },
+	{ { 0.54662188681851576, 1.9492442745143101 }, { 0.28328196857079913, 1.0703196553673227 } },
+	{ { 0.35739879234906785, 2.3360428198922643 }, { 0.092503113485009753, 0.91073367062425292 } },
+	{ { 0.54388828895638375, 1.4160428839760222 }, { 0.67435135057351769, 1.7186473923152177 } },
+	{ { 0.30915641872170097, 1.1568469284723957 }, { 0.42725296166785381, 1.414096700261857 } },
+	{ { 0.377286792328204, 1.6681526187098419 }, { 0.51496718991270318, 1.6890638930328685 } },
+	{ { 0.48678364231617499, 1.5295537418388359 }, { 0.41118433825235656, 1.4355663076832244 } },
+	{ { 0.79805914599696925, 1.1944500026454841 }, { 0.73356690494705856, 1.4045216940838006 } },
+	{ { 0.034961558514768988, 0.37558505601830816 }, { 0.16344042236322132, 0.80143362399164464 } },
+	{ { 0.20287146868090825, 1.0175865308342558 }, { 0.079432189138925524, 0.69165653147772921 } },
+	{ { 0.32510194893440192, 1.131419065107317 }, { 0.22706991344178151, 0.96148407786894907 } },
+	{ { 0.61244511798916057, 1.5341351927387672 }, { 0.45892604752639887, 1.6937549931478411 } },
+	{ { 0.34781854745505947, 1.2259548507435758 }, { 0.39158267635226651, 1.2057361938715419 } },
+	{ { 0.36397609016625815, 1.4366304163895893 }, { 0.24648935279342499, 1.466836520151559 } },
+	{ { 0.45149567962612347, 1.0545844856796847 }, { 0.29215867545314789, 1.0696710645175571 } },
+	{ { 0.67758319404737255, 1.1468946607762858 }, { 0.87082725922537707, 0.809159144971489 } },
+	{ { 0.041627590969577896, 0.44847522576260473 }, { 0.19670476947230733, 1.2195938700691826 } },
+	{ { 0.42740954556924482, 1.9318572025838638 }, { 0.28110810959040744, 1.6588133491243962 } },
+	{ { 0.62624225927883281, 2.0913654378409614 }, { 0.3583485112413507, 1.4586354619632047 } },
+	{ { 0.30847835056983341, 1.7233376927329223 }, { 0.64020211990931197, 1.7716930651365701 } },
+	{ { 0.46252836855740698, 1.5464652922848885 }, { 0.53362548678658184, 1.7597449071223279 } },
+	{ { 0.69314351437000066, 2.0637781379584581 }, { 0.63987088651545765, 2.0954913240827637 } },
+	{ { 0.7319021862883639, 1.0664768062233223 }, { 0.40900251678531707, 1.308449053639579 } },
+	{ { 0.95453797084845149, 0.44720353958973857 }, { 0.7505392073986491, 0.99540232828127406 } },
+	{ { 0.12412703426069274, 0.86326575961167273 }, { 0.27417023264212192, 1.1315816697311236 } },
+	{ { 0.57423443649543071, 1.3968554616542197 }, { 0.64552667211703096, 1.5733997505268773 } },
+	{ { 0.484133365975908, 1.4091012006194323 }, { 0.50034865882175461, 1.3245654328175021 } },
+	{ { 0.60170495102320953, 1.1372262200888739 }, { 0.64827065260553718, 1.3193491064510707 } },
+	{ { 0.60657504111519456, 1.5577482273585959 }, { 0.5464034605184156, 1.4203516593175425 } },
+	{ { 0.70401546424907702, 1.8491466999462021 }, { 0.89112699155340458, 1.4554967194042685 } },
+	{ { 0.52471845025290642, 1.2566850630247386 }, { 0.65664071307392713, 1.1382696374075709 } },
+	{ { 0.88124575341865286, 0.72625771037910458 }, { 0.90265321117254593, 0.66965422142273368 } },
+	{ { 0.48651079882431236, 1.6228374669237635 }, { 0.37322916305589393, 1.5308424186099301 } },
+	{ { 0.374426964225968, 1.8704218800742538 }, { 0.58902360648833474, 1.9764149153384261 } },
+	{ { 0.59339107736620134, 1.5390527753039971 }, { 0.62458479849916415, 1.9910915040423354 } },
+	{ { 0.8573296495544076, 0.96570011665197841 }, { 0.80287963997614564, 1.2470530716556114 } },
+	{ { 0.49576863432074814, 1.959135657495028 }, { 0.6522952582945345, 2.3190878753797266 } },
+	{ { 0.9844589505449588, 0.21679219368339067 }, { 0.95627922139356358, 0.49598676210504239 } },
+	{ { 0.68313030491930582, 1.3427306371289145 }, { 0.92113277057702292, 0.89532106891714625 } },
+	{ { 0.95817101710035046, 0.34655991151972348 }, { 0.98634310166105899, 0.17076774047642382 } },
+	{ { 2.2289555249187638e-07, 0.00010547408327663998 }, { 0.071497462742759504, 0.51723469808713951 } },
+	{ { 0.030306915736662113, 0.29447616883331723 }, { 0.085160949401247743, 0.76059255772781231 } },
+	{ { 0.056584979671444199, 0.55456882818976472 }, { 0.060191802796886199, 0.49768311115966313 } },
+	{ { 0.19839263231631721, 0.97460979333387499 }, { 0.22319051539262535, 1.19122963176193 } },
+	{ { 0.0034064162564984993, 0.074394250396623632 }, { 0.055062610152948506, 0.48682520657099804 } },
+	{ { 0.10735976124410951, 0.9831586660404491 }, { 0.083953635981522973, 0.7374644559725746 } },
+	{ { 0.25057869351333822, 1.1248435854934828 }, { 0.17058943574639313, 1.3155134205963321 } },
+	{ { 0.37325830552680206, 1.2141233134542975 }, { 0.2818827228138433, 1.3762634660359296 } },
+	{ { 0.11832909505940525, 0.73996087288712853 }, { 0.1758985982716465, 0.89673067509183713 } },
+	{ { 0.35034341573752326, 1.231225036995871 }, { 0.30127550197416275, 1.1018887629610561 } },
+	{ { 0.042018365318376327, 0.67573947420363234 }, { 0.13487255178848792, 0.87702450771684037 } },
+	{ { 0.4828510931156631, 1.5048789946443897 }, { 0.45240583537137224, 1.9132829863208753 } },
+	{ { 0.31469831300124856, 1.1114024527516477 }, { 0.50486244493896149, 1.3758367694050189 } },
+	{ { 0.51712892560249646, 1.3249489067342126 }, { 0.36863454826738695, 1.3125704435885912 } },
+	{ { 0.60162569804637323, 1.4824030935136272 }, { 0.60962694565949582, 1.7127725781450922 } },
+	{ { 0.63354954961906629, 1.2251316139297086 }, { 0.58308910753571019, 1.926135968582265 } },
+	{ { 0.13961367557134896, 0.80091056033799757 }, { 0.14192423703693274, 0.74496094874485563 } },
+	{ { 0.25039608342917169, 1.0209696612598043 }, { 0.23254234005748098, 1.0469830069356849 } },
+	{ { 0.18352688427043076, 1.1784930665714572 }, { 0.20529290862403107, 1.2525798288776144 } },
+	{ { 0.60276663160989741, 1.9023986192108286 }, { 0.50208090444557996, 1.5372045022935041 } },
+	{ { 0.2318829274833967, 1.2181298456102736 }, { 0.41358857721327419, 1.76523107151186 } },
+	{ { 0.36860783502870204, 1.7436851972358125 }, { 0.44110757331185158, 1.5021540354809677 } },
+	{ { 0.37036129952490865, 1.7916325343182873 }, { 0.25452026746707301, 1.3095426729441899 } },
+	{ { 0.60853096089976222, 2.0883749969494949 }, { 0.43089709834563955, 1.9361362020223605 } },
+	{ { 0.39459461865955836, 1.1744774014711394 }, { 0.38750636389340953, 1.1728025317726709 } },
+	{ { 0.78792917589543943, 1.0292645623365337 }, { 0.61197859545330591, 1.2480742675380911 } },
+	{ { 0.27210695941692287, 1.2453025451115947 }, { 0.25542722412163821, 1.2593938791018884 } },
+	{ { 0.55904711675210117, 1.2342522157244389 }, { 0.47140329638027223, 1.4989297278630174 } },
+	{ { 0.45799926166657073, 1.4570904421230086 }, { 0.68688465377545049, 1.596402265843428 } },
+	{ { 0.75629231440209921, 1.0012571951149363 }, { 0.52669459898179538, 1.3620307398365574 } },
+	{ { 0.61324748258136097, 2.3011962065578633 }, { 0.74860423103678486, 1.8749713183571415 } },
+	{ { 0.82159998397518008, 0.87172568374400372 }, { 0.98247450907010125, 0.29259689126569077 } },
+	{ { 0.059284614241177813, 0.54884438200875285 }, { 0.05694169653813537, 0.54425572890919982 } },
+	{ { 0.10127829488494036, 0.90327269534300914 }, { 0.055703268047386519, 0.5113010938705651 } },
+	{ { 0.044670875853597636, 0.46399296685812447 }, { 0.17772114335007877, 1.0466555983429013 } },
+	{ { 0.41031758259259149, 1.5361113967331355 }, { 0.29220593668274503, 1.3581311566709293 } },
+	{ { 0.031761021161359704, 0.35359886327859236 }, { 0.1637028162744753, 1.1527531648663873 } },
+	{ { 0.10215276839746423, 0.96186297940051857 }, { 0.06912569216459967, 0.75238823292706614 } },
+	{ { 0.30359704096121093, 1.5606195422286571 }, { 0.55104962040737693, 1.9129461308097735 } },
+	{ { 0.67948362185344036, 1.6488094313570465 }, { 0.44227383582446467, 1.6275149320652738 } },
+	{ { 0.047478701578462325, 0.43086850623168049 }, { 0.028522419188841415, 0.42847993605096191 } },
+	{ { 0.27752785566113769, 1.0512726995224841 }, { 0.14267901184704834, 0.8297659914226243 } },
+	{ { 0.35501382676464505, 1.8469281352797782 }, { 0.34645480930804962, 1.6816727220929859 } },
+	{ { 0.55101820529504353, 2.5634796439646825 }, { 0.48800407911384158, 1.6979563787692671 } },
+	{ { 0.2179263218580621, 1.2814090396994384 }, { 0.36096657785786657, 1.3026863925639305 } },
+	{ { 0.55773639272764519, 1.5277170451086302 }, { 0.43900122458797608, 1.3798051104906817 } },
+	{ { 0.51988030753711789, 2.0211988163733494 }, { 0.70799779070010882, 1.9541087433888471 } },
+	{ { 0.68850572976060065, 1.7543210023245606 }, { 0.81154729742463239, 1.8900677342949301 } },
+	{ { 0.1789210432850942, 0.87654935121504862 }, { 0.21968734647192972, 1.1221229030046853 } },
+	{ { 0.52135803553265458, 1.3198643090862128 }, { 0.3889662428459279, 1.2733699701339376 } },
+	{ { 0.41287280440633667, 1.4758688548785843 }, { 0.63145506013775643, 1.3688719910951261 } },
+	{ { 0.72946060768798016, 1.144141001407132 }, { 0.50142480260027411, 1.2998753448140108 } },
+	{ { 0.37292540335831509, 1.3168260817788737 }, { 0.35466986599132055, 1.1686469974067377 } },
+	{ { 0.61357164156486388, 1.6329315690093966 }, { 0.4757376741804254, 1.4339774005280714 } },
+	{ { 0.48480864565170018, 2.4417642821116186 }, { 0.25671944925181389, 2.070794906211181 } },
+	{ { 0.56217323176742873, 1.6176994205435729 }, { 0.84479130007177305, 1.1353556625733412 } },
+	{ { 0.45370359791341053, 1.4484472621480964 }, { 0.48769190052828421, 1.594407992539643 } },
+	{ { 0.76021161320011688, 0.99301903383784673 }, { 0.61319141469765448, 1.2600450960017775 } },
+	{ { 0.45908211913092623, 1.7625679958811875 }, { 0.61276254869710889, 1.7946170432733277 } },
+	{ { 0.7887300294129953, 0.95368630525174325 }, { 0.92068686675889211, 0.56390820855836776 } },
+	{ { 0.45377117679077528, 2.1926657517890833 }, { 0.6605028833630493, 1.9770942268349381 } },
+	{ { 0.7719304926718622, 1.1651538937534469 }, { 0.93864439696517377, 0.83324950582405222 } },
+	{ { 0.9590061753839566, 0.42616981887489008 }, { 0.91966576575440018, 0.69167541728725934 } },
+	{ { 0.94879660483159145, 0.43471794977848804 }, { 0.97398828275007254, 0.26261635793435339 } },
+	{ { 0.18605235362109651, 0.9290585166419546 }, { 0.13097369098238065, 0.7133136834411784 } },
+	{ { 0.13902110514278648, 1.156475399478238 }, { 0.068299630620184029, 0.65890072304422442 } },
+	{ { 0.11215713068221651, 0.89562328695146565 }, { 0.13204104826939783, 0.9636043783486361 } },
+	{ { 0.20956582982668448, 1.4825991285520757 }, { 0.15098796502085637, 0.93601025579518748 } },
+	{ { 0.44813513797053084, 1.5530915135093337 }, { 0.23985647527247408, 1.0091133246090211 } },
+	{ { 0.41540591437273489, 1.5652151336023834 }, { 0.17923810620005715, 1.0401242539785236 } },
+	{ { 0.50802509005726437, 1.3772914721570768 }, { 0.58201792341220349, 1.806381439790697 } },
+	{ { 0.42240686256389542, 2.0769990320423402 }, { 0.55412700084025746, 1.8974623856649973 } },
+	{ { 0.2586810900513738, 1.047902583161878 }, { 0.65464438809924541, 1.2666615784325561 } },
+	{ { 0.63754139139848043, 1.4846236342814041 }, { 0.33930381843182816, 1.4677913384028483 } },
+	{ { 0.39415246785888636, 1.5371299307188118 }, { 0.26855393300143482, 1.4648733496096726 } },
+	{ { 0.49612384242600027, 2.1328896787480653 }, { 0.4214419059822081, 2.1442484907775898 } },
+	{ { 0.74790107705188513, 1.078979990621213 }, { 0.43326967105966407, 1.1356648893366277 } },
+	{ { 0.5111392813075325, 1.4615712003716235 }, { 0.84261525116001335, 1.0087711791128793 } },
+	{ { 0.62681546541655453, 1.2666256962603168 }, { 0.36426340740408736, 1.4533486306968544 } },
+	{ { 0.97524372506647738, 0.30562977607237496 }, { 0.74770667255999357, 0.9903468926788408 } },
+	{ { 0.57869942256383922, 1.6793313643089545 }, { 0.22387871267252341, 0.96609090409147114 } },
+	{ { 0.34265664213895997, 1.3743328968205364 }, { 0.52488359892560676, 1.8997715734785823 } },
+	{ { 0.26631491331990242, 1.1564913007935271 }, { 0.40939184011262997, 1.5516354513529547 } },
+	{ { 0.5045289725640536, 2.1206239977689818 }, { 0.71614541321335878, 2.5131167241607093 } },
+	{ { 0.29337749724096118, 1.5639220438482431 }, { 0.4643296044506251, 1.3958830466687131 } },
+	{ { 0.4809537864847796, 2.1410112409024347 }, { 0.5183972909250596, 1.7798504807909183 } },
+	{ { 0.4664990291345788, 1.6513691724907176 }, { 0.49676285639312739, 1.8385509997705731 } },
+	{ { 0.90709757809244929, 0.75876102214361052 }, { 0.87833575354639903, 0.8988468940068699 } },
+	{ { 0.34806090116875288, 1.2218378936181833 }, { 0.56405071303849474, 1.2616500141810476 } },
+	{ { 0.69437521190321927, 1.1694194638119184 }, { 0.61976440292619617, 1.1972614424023025 } },
+	{ { 0.48269495203254004, 1.5546668627629794 }, { 0.42517901752714227, 1.4832293498128459 } },
+	{ { 0.72621185814292755, 1.4653684925448571 }, { 0.78024349592443221, 1.1906985830574126 } },
+	{ { 0.55884348117550375, 1.2550760084612549 }, { 0.54352997292518779, 1.2953374876937418 } },
+	{ { 0.78543618571640683, 0.98194796985081845 }, { 0.83681291889698106, 0.80372778840342551 } },
+	{ { 0.61469543780367242, 1.5989200136960666 }, { 0.67431408573931961, 1.7296893221060039 } },
+	{ { 0.96607734160112757, 0.3217054500141559 }, { 0.96537079704301132, 0.30827977743815743 } },
+	{ { 0.30583870642016298, 1.2393524135391623 }, { 0.4404774759012513, 1.1437012166663902 } },
+	{ { 0.37922084283474783, 1.4511057156152929 }, { 0.2639401305446098, 1.1347799109796779 } },
+	{ { 0.49572582704756507, 1.8775448179351903 }, { 0.47870084739078844, 1.7778742243511809 } },
+	{ { 0.61730720265058825, 1.8038268835478273 }, { 0.69082053260139564, 2.3171925456064946 } },
+	{ { 0.61347902298667056, 1.2574206220342561 }, { 0.38204848227583244, 1.2582510423165967 } },
+	{ { 0.41822350366207101, 1.4172965662041461 }, { 0.86191454684611279, 1.9025270029290877 } },
+	{ { 0.53991106951057888, 1.2974064718526117 }, { 0.64519462087098778, 1.2417177041728951 } },
+	{ { 0.69810128454758336, 1.4331565021405204 }, { 0.8550221273119093, 1.0592432797242606 } },
+	{ { 0.54213006454901791, 1.6155126958023402 }, { 0.50936590192441311, 1.4076577513940052 } },
+	{ { 0.29448453339597441, 1.7849688098988368 }, { 0.64668630833098284, 2.1260306136407099 } },
+	{ { 0.52617163986607052, 1.9430228378547949 }, { 0.36446549330975819, 2.2290187061588123 } },
+	{ { 0.9517859881639561, 0.47113379359788493 }, { 0.98414679478355038, 0.25825334673276579 } },
+	{ { 0.5293863070263537, 1.1740144042255374 }, { 0.644665470754478, 1.1345791467954607 } },
+	{ { 0.88598993240518098, 0.96018060197701649 }, { 0.80727988067887912, 1.4070778438798608 } },
+	{ { 0.77654182865632371, 1.1046609564605097 }, { 0.9079200407011212, 0.80345776738557073 } },
+	{ { 0.8922100410394207, 0.65209063722875316 }, { 0.92779553103546231, 0.50000538880886192 } },
+	{ { 0.63249755716958367, 1.06494672788804 }, { 0.45355150722283738, 1.044361205321872 } },
+	{ { 0.68497773580685561, 1.1769732676396774 }, { 0.62901773359558799, 1.1723934274464491 } },
+	{ { 0.70587833836152991, 1.0845989443792619 }, { 0.65172940226024578, 1.1269066513094401 } },
+	{ { 0.92539670439648214, 0.53578567426963397 }, { 0.7284783239572783, 1.0475281892181532 } },
+	{ { 0.77029332639560799, 1.1988233054776343 }, { 0.81679632227887855, 0.89356741017102193 } },
+	{ { 0.74539140100735102, 1.8133208427225753 }, { 0.74928627909652579, 1.4746088170144616 } },
+	{ { 0.84098108164850027, 0.80674024399924316 }, { 0.84606524475255795, 0.79071802748379838 } },
+	{ { 0.97161613660573043, 0.26868488619585418 }, { 0.99783888565117163, 0.050505298876858 } },
+	{ { 0.67181115682548964, 1.1195486949435971 }, { 0.65330080795668943, 1.155553981362679 } },
+	{ { 0.94119566145721623, 0.55516450191969025 }, { 0.8730431084533945, 0.71928014432802678 } },
+	{ { 0.85016039093406004, 1.0225108138407046 }, { 0.65664891086709487, 1.3749929012398572 } },
+	{ { 0.96872969077035442, 0.29552805561706058 }, { 0.99375759192595681, 0.11754914369347516 } },
+	{ { 0.89633902616361583, 0.7966706147647884 }, { 0.86593738895095052, 0.96728663806888004 } },
+	{ { 0.96999956646144847, 0.28498983342922962 }, { 0.96320896370267717, 0.35092155816259057 } },
+	{ { 0.9911617800750967, 0.12597933422519353 }, { 0.98837954576014142, 0.14802124295586958 } },
+	{ { 1, 0 }, { 1, 0 } },
+};
+
+#endif